@@ -0,0 +1,205 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverstore.h"
+
+#include <QObject>
+#include <QString>
+#include <QBuffer>
+#include <QColor>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QUrl>
+
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class CoverStoreTests: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    static QByteArray encodedImage(Qt::GlobalColor color)
+    {
+        auto image = QImage{300, 300, QImage::Format_RGB32};
+        image.fill(color);
+
+        QByteArray result;
+        QBuffer imageBuffer(&result);
+        imageBuffer.open(QIODevice::WriteOnly);
+        image.save(&imageBuffer, "PNG");
+
+        return result;
+    }
+
+    static bool writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile oneFile(fileName);
+        if (!oneFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return oneFile.write(content) == content.size();
+    }
+
+    static bool setModificationTime(const QString &fileName, const QDateTime &time)
+    {
+        QFile oneFile(fileName);
+        if (!oneFile.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+
+        return oneFile.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+    static qsizetype filesCount(const QString &directoryPath)
+    {
+        return QDir(directoryPath).entryList(QDir::Files).size();
+    }
+
+private Q_SLOTS:
+
+    void storeDirectoriesAreCreatedOnFirstCover()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto storePath = musicDirectory.filePath(u"store"_s);
+
+        CoverStore store{storePath};
+
+        QVERIFY(!QFileInfo::exists(storePath));
+        QVERIFY(store.coverHash(musicDirectory.filePath(u"track1.ogg"_s)).isEmpty());
+        QVERIFY(!QFileInfo::exists(storePath));
+
+        const auto trackFileName = musicDirectory.filePath(u"track1.ogg"_s);
+        QVERIFY(writeFile(trackFileName, "track1"));
+
+        QVERIFY(!store.storeCover(trackFileName, encodedImage(Qt::red)).isEmpty());
+        QVERIFY(QFileInfo::exists(storePath));
+    }
+
+    void storeAndReadCover()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto trackFileName = musicDirectory.filePath(u"track1.ogg"_s);
+        QVERIFY(writeFile(trackFileName, "track1"));
+
+        CoverStore store{musicDirectory.filePath(u"store"_s)};
+
+        const auto hash = store.storeCover(trackFileName, encodedImage(Qt::red));
+        QVERIFY(!hash.isEmpty());
+        QCOMPARE(store.coverHash(trackFileName), hash);
+
+        const auto smallCover = store.cover(trackFileName, {50, 50});
+        QCOMPARE(smallCover.size(), QSize(64, 64));
+        QCOMPARE(smallCover.pixelColor(0, 0), QColor{Qt::red});
+
+        QCOMPARE(store.cover(trackFileName, {100, 200}).size(), QSize(256, 256));
+        QVERIFY(store.cover(trackFileName, {512, 512}).isNull());
+
+        QVERIFY(CoverStore::hasThumbnailFor({256, 100}));
+        QVERIFY(!CoverStore::hasThumbnailFor({257, 100}));
+
+        QVERIFY(store.cover(musicDirectory.filePath(u"track2.ogg"_s), {64, 64}).isNull());
+    }
+
+    void sameImageIsStoredOnce()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto storePath = musicDirectory.filePath(u"store"_s);
+        CoverStore store{storePath};
+
+        for (int i = 0; i < 10; ++i) {
+            const auto trackFileName = musicDirectory.filePath(u"track%1.ogg"_s.arg(i));
+            QVERIFY(writeFile(trackFileName, "track"));
+            QVERIFY(!store.storeCover(trackFileName, encodedImage(Qt::red)).isEmpty());
+        }
+
+        QCOMPARE(filesCount(storePath + u"/files"_s), 10);
+        QCOMPARE(filesCount(storePath + u"/thumbnails"_s), qsizetype{CoverStore::ThumbnailSizes.size()});
+    }
+
+    void modifiedFileInvalidatesCover()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto trackFileName = musicDirectory.filePath(u"track1.ogg"_s);
+        QVERIFY(writeFile(trackFileName, "track1"));
+
+        const auto storePath = musicDirectory.filePath(u"store"_s);
+        CoverStore store{storePath};
+
+        QVERIFY(!store.storeCover(trackFileName, encodedImage(Qt::red)).isEmpty());
+
+        QVERIFY(setModificationTime(trackFileName, QFileInfo(trackFileName).lastModified().addSecs(10)));
+
+        QVERIFY(store.coverHash(trackFileName).isEmpty());
+        QVERIFY(store.cover(trackFileName, {64, 64}).isNull());
+
+        // the new version of the file replaces the cover of the previous one
+        const auto hash = store.storeCover(trackFileName, encodedImage(Qt::blue));
+        QCOMPARE(store.coverHash(trackFileName), hash);
+        QCOMPARE(store.cover(trackFileName, {64, 64}).pixelColor(0, 0), QColor{Qt::blue});
+        QCOMPARE(filesCount(storePath + u"/files"_s), 1);
+    }
+
+    void removedFilesReleaseTheirThumbnails()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto storePath = musicDirectory.filePath(u"store"_s);
+        CoverStore store{storePath};
+
+        const auto firstTrack = musicDirectory.filePath(u"track1.ogg"_s);
+        const auto secondTrack = musicDirectory.filePath(u"track2.ogg"_s);
+        const auto thirdTrack = musicDirectory.filePath(u"track3.ogg"_s);
+        QVERIFY(writeFile(firstTrack, "track1"));
+        QVERIFY(writeFile(secondTrack, "track2"));
+        QVERIFY(writeFile(thirdTrack, "track3"));
+
+        QVERIFY(!store.storeCover(firstTrack, encodedImage(Qt::red)).isEmpty());
+        QVERIFY(!store.storeCover(secondTrack, encodedImage(Qt::red)).isEmpty());
+        QVERIFY(!store.storeCover(thirdTrack, encodedImage(Qt::blue)).isEmpty());
+
+        QCOMPARE(filesCount(storePath + u"/thumbnails"_s), qsizetype{2 * CoverStore::ThumbnailSizes.size()});
+
+        QVERIFY(QFile::remove(firstTrack));
+        QVERIFY(QFile::remove(thirdTrack));
+
+        QCOMPARE(store.removeCovers({QUrl::fromLocalFile(firstTrack), QUrl::fromLocalFile(thirdTrack), QUrl::fromLocalFile(thirdTrack)}), 2);
+        QCOMPARE(filesCount(storePath + u"/files"_s), 1);
+
+        store.removeUnusedThumbnails();
+
+        // the red image is still used by the second track
+        QCOMPARE(filesCount(storePath + u"/thumbnails"_s), qsizetype{CoverStore::ThumbnailSizes.size()});
+        QCOMPARE(store.cover(secondTrack, {64, 64}).pixelColor(0, 0), QColor{Qt::red});
+
+        QCOMPARE(store.removeCovers({QUrl::fromLocalFile(secondTrack)}), 1);
+        store.removeUnusedThumbnails();
+
+        QCOMPARE(filesCount(storePath + u"/files"_s), 0);
+        QCOMPARE(filesCount(storePath + u"/thumbnails"_s), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(CoverStoreTests)
+
+
+#include "coverstoretest.moc"
@@ -0,0 +1,204 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverthumbnailcache.h"
+
+#include <QObject>
+#include <QColor>
+#include <QString>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class CoverThumbnailCacheTests: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    static QImage thumbnail(Qt::GlobalColor color)
+    {
+        auto result = QImage{64, 64, QImage::Format_RGB32};
+        result.fill(color);
+        return result;
+    }
+
+    static bool isThumbnail(const QImage &image, Qt::GlobalColor color)
+    {
+        return image.size() == QSize{64, 64} && image.pixelColor(0, 0) == QColor{color};
+    }
+
+    static bool writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile oneFile(fileName);
+        if (!oneFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return oneFile.write(content) == content.size();
+    }
+
+    static bool setModificationTime(const QString &fileName, const QDateTime &time)
+    {
+        QFile oneFile(fileName);
+        if (!oneFile.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+
+        return oneFile.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+private Q_SLOTS:
+
+    void cacheHitAndMiss()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto trackFileName = cacheDirectory.filePath(u"track.ogg"_s);
+        QVERIFY(writeFile(trackFileName, "track"));
+
+        const auto key = CoverThumbnailCache::cacheKey(trackFileName, {64, 64});
+
+        CoverThumbnailCache cache{cacheDirectory.filePath(u"covers"_s)};
+
+        QVERIFY(cache.image(key).isNull());
+        QCOMPARE(cache.misses(), quint64{1});
+        QCOMPARE(cache.hits(), quint64{0});
+
+        cache.insert(key, thumbnail(Qt::red));
+
+        QVERIFY(isThumbnail(cache.image(key), Qt::red));
+        QCOMPARE(cache.hits(), quint64{1});
+
+        QVERIFY(CoverThumbnailCache::cacheKey(trackFileName, {128, 128}) != key);
+        QVERIFY(cache.image(CoverThumbnailCache::cacheKey(trackFileName, {128, 128})).isNull());
+        QCOMPARE(cache.misses(), quint64{2});
+
+        // a new cache only finds the thumbnail on disk
+        CoverThumbnailCache otherCache{cacheDirectory.filePath(u"covers"_s)};
+
+        QVERIFY(isThumbnail(otherCache.image(key), Qt::red));
+        QCOMPARE(otherCache.hits(), quint64{1});
+        QCOMPARE(otherCache.misses(), quint64{0});
+    }
+
+    void modifiedFileInvalidatesThumbnail()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto trackFileName = cacheDirectory.filePath(u"track.ogg"_s);
+        QVERIFY(writeFile(trackFileName, "track"));
+
+        const auto key = CoverThumbnailCache::cacheKey(trackFileName, {64, 64});
+
+        CoverThumbnailCache cache{cacheDirectory.filePath(u"covers"_s)};
+        cache.insert(key, thumbnail(Qt::red));
+
+        QVERIFY(setModificationTime(trackFileName, QFileInfo(trackFileName).lastModified().addSecs(10)));
+
+        const auto modifiedTimeKey = CoverThumbnailCache::cacheKey(trackFileName, {64, 64});
+        QVERIFY(modifiedTimeKey != key);
+        QVERIFY(cache.image(modifiedTimeKey).isNull());
+
+        const auto modificationTime = QFileInfo(trackFileName).lastModified();
+        QVERIFY(writeFile(trackFileName, "modified track"));
+        QVERIFY(setModificationTime(trackFileName, modificationTime));
+
+        const auto modifiedSizeKey = CoverThumbnailCache::cacheKey(trackFileName, {64, 64});
+        QVERIFY(modifiedSizeKey != modifiedTimeKey);
+        QVERIFY(modifiedSizeKey != key);
+        QVERIFY(cache.image(modifiedSizeKey).isNull());
+
+        QCOMPARE(cache.misses(), quint64{2});
+        QCOMPARE(cache.hits(), quint64{0});
+    }
+
+    void pruneLeastRecentlyUsedThumbnails()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto coversPath = cacheDirectory.filePath(u"covers"_s);
+        const auto keys = QStringList{u"first"_s, u"second"_s, u"third"_s};
+
+        {
+            CoverThumbnailCache cache{coversPath};
+            cache.insert(keys.at(0), thumbnail(Qt::red));
+            cache.insert(keys.at(1), thumbnail(Qt::green));
+            cache.insert(keys.at(2), thumbnail(Qt::blue));
+        }
+
+        auto thumbnailsBytes = qint64{0};
+        const auto oldTime = QDateTime::currentDateTimeUtc().addDays(-3);
+        for (int i = 0; i < keys.size(); ++i) {
+            const auto thumbnailFileName = QDir(coversPath).filePath(keys.at(i) + u".png"_s);
+            QVERIFY(setModificationTime(thumbnailFileName, oldTime.addSecs(i)));
+            thumbnailsBytes += QFileInfo(thumbnailFileName).size();
+        }
+
+        // only the oldest thumbnail must be removed to fit in the cache
+        CoverThumbnailCache cache{coversPath, thumbnailsBytes - 1};
+
+        // reading the oldest thumbnail makes the second one the least recently used
+        QVERIFY(isThumbnail(cache.image(keys.at(0)), Qt::red));
+
+        cache.prune();
+
+        QVERIFY(QFileInfo::exists(QDir(coversPath).filePath(keys.at(0) + u".png"_s)));
+        QVERIFY(!QFileInfo::exists(QDir(coversPath).filePath(keys.at(1) + u".png"_s)));
+        QVERIFY(QFileInfo::exists(QDir(coversPath).filePath(keys.at(2) + u".png"_s)));
+
+        CoverThumbnailCache otherCache{coversPath};
+        QVERIFY(otherCache.image(keys.at(1)).isNull());
+        QVERIFY(isThumbnail(otherCache.image(keys.at(2)), Qt::blue));
+    }
+
+    void insertionKeepsCacheBounded()
+    {
+        QTemporaryDir cacheDirectory;
+        QVERIFY(cacheDirectory.isValid());
+
+        const auto coversPath = cacheDirectory.filePath(u"covers"_s);
+
+        auto thumbnailBytes = qint64{0};
+        {
+            CoverThumbnailCache cache{coversPath};
+            cache.insert(u"size"_s, thumbnail(Qt::red));
+            thumbnailBytes = QFileInfo(QDir(coversPath).filePath(u"size.png"_s)).size();
+            QVERIFY(QFile::remove(QDir(coversPath).filePath(u"size.png"_s)));
+        }
+        QVERIFY(thumbnailBytes > 0);
+
+        CoverThumbnailCache cache{coversPath, 4 * thumbnailBytes};
+
+        for (int i = 0; i < 20; ++i) {
+            cache.insert(QString::number(i), thumbnail(Qt::red));
+        }
+
+        auto diskBytes = qint64{0};
+        const auto allThumbnails = QDir(coversPath).entryInfoList(QDir::Files);
+        for (const auto &oneThumbnail : allThumbnails) {
+            diskBytes += oneThumbnail.size();
+        }
+
+        QVERIFY(!allThumbnails.isEmpty());
+        QVERIFY(diskBytes <= 4 * thumbnailBytes);
+    }
+};
+
+QTEST_GUILESS_MAIN(CoverThumbnailCacheTests)
+
+
+#include "coverthumbnailcachetest.moc"
@@ -7,6 +7,7 @@
 #include "databasetestdata.h"
 
 #include "databaseinterface.h"
+#include "modeldataloader.h"
 #include "datatypes.h"
 
 #include "config-upnp-qt.h"
@@ -1111,6 +1112,69 @@ private Q_SLOTS:
         }
     }
 
+    void readOnlyConnectionWithDatabaseFile()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+        musicDb.init(QStringLiteral("testDbWriter"), myTempDatabase.fileName());
+
+        musicDb.insertTracksList(mNewTracks);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDb.allAlbumsData().count(), 5);
+
+        {
+            auto journalModeDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), QStringLiteral("testDbJournalMode"));
+            journalModeDatabase.setDatabaseName(myTempDatabase.fileName());
+            QVERIFY(journalModeDatabase.open());
+
+            QSqlQuery journalModeQuery{QStringLiteral("PRAGMA journal_mode;"), journalModeDatabase};
+            QVERIFY(journalModeQuery.next());
+            QCOMPARE(journalModeQuery.value(0).toString(), QStringLiteral("wal"));
+        }
+        QSqlDatabase::removeDatabase(QStringLiteral("testDbJournalMode"));
+
+        DatabaseInterface readOnlyMusicDb;
+
+        QSignalSpy readOnlyMusicDbErrorSpy(&readOnlyMusicDb, &DatabaseInterface::databaseError);
+
+        readOnlyMusicDb.initReadOnly(QStringLiteral("testDbReader"), myTempDatabase.fileName());
+
+        QCOMPARE(readOnlyMusicDbErrorSpy.count(), 0);
+        QCOMPARE(readOnlyMusicDb.allAlbumsData().count(), 5);
+        QCOMPARE(readOnlyMusicDb.allTracksData().count(), musicDb.allTracksData().count());
+
+        auto firstAlbum = readOnlyMusicDb.albumDataFromDatabaseId(musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"), QStringLiteral("/")));
+
+        QCOMPARE(firstAlbum.isValid(), true);
+        QCOMPARE(firstAlbum.title(), QStringLiteral("album1"));
+
+        auto newTrack = DataTypes::TrackDataType{true, QStringLiteral("$100"), QStringLiteral("0"), QStringLiteral("track100"),
+                QStringLiteral("artist2"), QStringLiteral("album6"), QStringLiteral("artist2"),
+                1, 1, QTime::fromMSecsSinceStartOfDay(100), {QUrl::fromLocalFile(QStringLiteral("/$100"))},
+                QDateTime::fromMSecsSinceEpoch(100),
+        {QUrl::fromLocalFile(QStringLiteral("album6"))}, 5, true,
+                QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false};
+        auto newTracks = DataTypes::ListTrackDataType();
+        newTracks.push_back(newTrack);
+
+        musicDb.insertTracksList(newTracks);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(readOnlyMusicDb.allAlbumsData().count(), 6);
+        QCOMPARE(readOnlyMusicDbErrorSpy.count(), 0);
+
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-wal"));
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-shm"));
+    }
+
     void restoreModifiedTracksWidthDatabaseFile()
     {
         QTemporaryFile myTempDatabase;
@@ -2864,6 +2928,121 @@ private Q_SLOTS:
         QVERIFY(musicDb.allGenresData().isEmpty());
     }
 
+    void removeManyTracks()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(testConnectionName);
+
+        QSignalSpy trackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy albumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy albumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy artistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy genreRemovedSpy(&musicDb, &DatabaseInterface::genreRemoved);
+        QSignalSpy composerRemovedSpy(&musicDb, &DatabaseInterface::composerRemoved);
+        QSignalSpy lyricistRemovedSpy(&musicDb, &DatabaseInterface::lyricistRemoved);
+        QSignalSpy databaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType{};
+        auto removedTracks = QList<QUrl>{};
+
+        // large enough to use the bulk removal of tracks
+        for (int i = 1; i <= 150; ++i) {
+            newTracks.push_back({true, QStringLiteral("$%1").arg(i), QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                                 QStringLiteral("artist1"), QStringLiteral("album1"), QStringLiteral("artist1"),
+                                 i, 1, QTime::fromMSecsSinceStartOfDay(i), QUrl::fromLocalFile(QStringLiteral("/removed/$%1").arg(i)),
+                                 QDateTime::fromMSecsSinceEpoch(i), {}, 1, true,
+                                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+            removedTracks.push_back(newTracks.last().resourceURI());
+        }
+
+        newTracks.push_back({true, QStringLiteral("$0"), QStringLiteral("0"), QStringLiteral("track0"),
+                             QStringLiteral("artist1"), QStringLiteral("album2"), QStringLiteral("artist1"),
+                             1, 1, QTime::fromMSecsSinceStartOfDay(1), QUrl::fromLocalFile(QStringLiteral("/kept/$0")),
+                             QDateTime::fromMSecsSinceEpoch(1), {}, 1, true,
+                             QStringLiteral("genre1"), QStringLiteral("composer2"), QStringLiteral("lyricist2"), false});
+
+        musicDb.insertTracksList(newTracks);
+
+        trackAddedSpy.wait(300);
+
+        QCOMPARE(trackAddedSpy.count(), 1);
+        QCOMPARE(databaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allTracksData().count(), 151);
+        QCOMPARE(musicDb.allAlbumsData().count(), 2);
+
+        musicDb.removeTracksList(removedTracks);
+
+        QCOMPARE(trackRemovedSpy.count(), 150);
+        QCOMPARE(albumRemovedSpy.count(), 1);
+        QCOMPARE(albumModifiedSpy.count(), 0);
+        QCOMPARE(artistRemovedSpy.count(), 0);
+        QCOMPARE(genreRemovedSpy.count(), 0);
+        QCOMPARE(composerRemovedSpy.count(), 1);
+        QCOMPARE(lyricistRemovedSpy.count(), 1);
+        QCOMPARE(databaseErrorSpy.count(), 0);
+
+        const auto remainingTracks = musicDb.allTracksData();
+        QCOMPARE(remainingTracks.count(), 1);
+        QCOMPARE(remainingTracks.first().title(), QStringLiteral("track0"));
+        QCOMPARE(musicDb.allAlbumsData().count(), 1);
+        QCOMPARE(musicDb.allArtistsData().count(), 1);
+        QCOMPARE(musicDb.allGenresData().count(), 1);
+        QCOMPARE(musicDb.trackIdFromFileName(removedTracks.first()), qulonglong(0));
+    }
+
+    void removeManyTracksOfManyAlbums()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(testConnectionName);
+
+        QSignalSpy trackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy albumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy albumModifiedSpy(&musicDb, &DatabaseInterface::albumModified);
+        QSignalSpy databaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        auto newTracks = DataTypes::ListTrackDataType{};
+        auto removedTracks = QList<QUrl>{};
+
+        // large enough to use the bulk removal of tracks, spread over 15 albums
+        for (int i = 1; i <= 150; ++i) {
+            newTracks.push_back({true, QStringLiteral("$%1").arg(i), QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                                 QStringLiteral("artist1"), QStringLiteral("album%1").arg(i % 15), QStringLiteral("artist1"),
+                                 i, 1, QTime::fromMSecsSinceStartOfDay(i), QUrl::fromLocalFile(QStringLiteral("/removed/$%1").arg(i)),
+                                 QDateTime::fromMSecsSinceEpoch(i), {}, 1, true,
+                                 QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+            removedTracks.push_back(newTracks.last().resourceURI());
+        }
+
+        // album0 keeps one track
+        newTracks.push_back({true, QStringLiteral("$0"), QStringLiteral("0"), QStringLiteral("track0"),
+                             QStringLiteral("artist1"), QStringLiteral("album0"), QStringLiteral("artist1"),
+                             151, 1, QTime::fromMSecsSinceStartOfDay(1), QUrl::fromLocalFile(QStringLiteral("/removed/$0")),
+                             QDateTime::fromMSecsSinceEpoch(1), {}, 1, true,
+                             QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+
+        musicDb.insertTracksList(newTracks);
+
+        trackAddedSpy.wait(300);
+
+        QCOMPARE(trackAddedSpy.count(), 1);
+        QCOMPARE(databaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allAlbumsData().count(), 15);
+
+        musicDb.removeTracksList(removedTracks);
+
+        QCOMPARE(trackRemovedSpy.count(), 150);
+        QCOMPARE(albumRemovedSpy.count(), 14);
+        QCOMPARE(albumModifiedSpy.count(), 1);
+        QCOMPARE(databaseErrorSpy.count(), 0);
+
+        const auto remainingAlbums = musicDb.allAlbumsData();
+        QCOMPARE(remainingAlbums.count(), 1);
+        QCOMPARE(remainingAlbums.first().title(), QStringLiteral("album0"));
+        QCOMPARE(musicDb.albumData(remainingAlbums.first().databaseId()).count(), 1);
+    }
+
     void addOneTrack()
     {
         DatabaseInterface musicDb;
@@ -5169,6 +5348,145 @@ private Q_SLOTS:
         QCOMPARE(frequentlyPlayedTracksData[4].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$18")));
     }
 
+    void replayPlayStatisticsAfterCrash()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+            musicDb.init(QStringLiteral("testDbStatistics1"), myTempDatabase.fileName());
+
+            musicDb.insertTracksList(mNewTracks);
+
+            musicDbTrackAddedSpy.wait(300);
+
+            musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553279650));
+            musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553279650));
+            musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$17")), QDateTime::fromSecsSinceEpoch(1553289720));
+            musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$17")), QDateTime::fromSecsSinceEpoch(1553289720));
+            musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553289740));
+            musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553289740));
+
+            // destroyed before the buffered play events are written to the database
+        }
+
+        QFile playStatisticsJournal(myTempDatabase.fileName() + QStringLiteral("-statistics"));
+        QVERIFY(playStatisticsJournal.exists());
+        QVERIFY(playStatisticsJournal.size() > 0);
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            musicDb.init(QStringLiteral("testDbStatistics2"), myTempDatabase.fileName());
+
+            QCOMPARE(playStatisticsJournal.size(), 0);
+
+            auto frequentlyPlayedTracksData = musicDb.frequentlyPlayedTracksData(5);
+
+            QCOMPARE(frequentlyPlayedTracksData.count(), 2);
+            QCOMPARE(frequentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+            QCOMPARE(frequentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+
+            auto recentlyPlayedTracksData = musicDb.recentlyPlayedTracksData(5);
+
+            QCOMPARE(recentlyPlayedTracksData.count(), 2);
+            QCOMPARE(recentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+            QCOMPARE(recentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+            // the replayed events are in the database file, not only in the instance that replayed them
+            DatabaseInterface readOnlyMusicDb;
+
+            QSignalSpy readOnlyMusicDbErrorSpy(&readOnlyMusicDb, &DatabaseInterface::databaseError);
+
+            readOnlyMusicDb.initReadOnly(QStringLiteral("testDbStatisticsReader"), myTempDatabase.fileName());
+
+            auto readOnlyFrequentlyPlayedTracksData = readOnlyMusicDb.frequentlyPlayedTracksData(5);
+
+            QCOMPARE(readOnlyFrequentlyPlayedTracksData.count(), 2);
+            QCOMPARE(readOnlyFrequentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+            QCOMPARE(readOnlyFrequentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+
+            auto readOnlyRecentlyPlayedTracksData = readOnlyMusicDb.recentlyPlayedTracksData(5);
+
+            QCOMPARE(readOnlyRecentlyPlayedTracksData.count(), 2);
+            QCOMPARE(readOnlyRecentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+            QCOMPARE(readOnlyRecentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+            QCOMPARE(readOnlyMusicDbErrorSpy.count(), 0);
+        }
+
+        playStatisticsJournal.remove();
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-wal"));
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-shm"));
+    }
+
+    void readBufferedPlayStatisticsFromReadOnlyDatabase()
+    {
+        QTemporaryFile myTempDatabase;
+        myTempDatabase.open();
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+
+        musicDb.init(QStringLiteral("testDbBufferedStatisticsWriter"), myTempDatabase.fileName());
+
+        musicDb.insertTracksList(mNewTracks);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        DatabaseInterface readOnlyMusicDb;
+
+        readOnlyMusicDb.initReadOnly(QStringLiteral("testDbBufferedStatisticsReader"), myTempDatabase.fileName());
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553279650));
+        musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553279650));
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$17")), QDateTime::fromSecsSinceEpoch(1553289720));
+        musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$17")), QDateTime::fromSecsSinceEpoch(1553289720));
+
+        // the play events are still buffered by the writer
+        QCOMPARE(readOnlyMusicDb.recentlyPlayedTracksData(5).count(), 0);
+
+        ModelDataLoader dataLoader;
+        dataLoader.setDatabase(&musicDb);
+        dataLoader.setReadOnlyDatabase(&readOnlyMusicDb);
+
+        QSignalSpy allTracksDataSpy(&dataLoader, &ModelDataLoader::allTracksData);
+
+        dataLoader.loadRecentlyPlayedData(ElisaUtils::Track);
+
+        QCOMPARE(allTracksDataSpy.count(), 1);
+
+        auto recentlyPlayedTracksData = allTracksDataSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+
+        QCOMPARE(recentlyPlayedTracksData.count(), 2);
+        QCOMPARE(recentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+        QCOMPARE(recentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+
+        musicDb.trackHasStartedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553289740));
+        musicDb.trackHasFinishedPlaying(QUrl::fromLocalFile(QStringLiteral("/$9")), QDateTime::fromSecsSinceEpoch(1553289740));
+
+        dataLoader.loadFrequentlyPlayedData(ElisaUtils::Track);
+
+        QCOMPARE(allTracksDataSpy.count(), 2);
+
+        auto frequentlyPlayedTracksData = allTracksDataSpy.at(1).at(0).value<DataTypes::ListTrackDataType>();
+
+        QCOMPARE(frequentlyPlayedTracksData.count(), 2);
+        QCOMPARE(frequentlyPlayedTracksData[0].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$9")));
+        QCOMPARE(frequentlyPlayedTracksData[1].resourceURI(), QUrl::fromLocalFile(QStringLiteral("/$17")));
+
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-statistics"));
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-wal"));
+        QFile::remove(myTempDatabase.fileName() + QStringLiteral("-shm"));
+    }
+
     void readAllGenresData()
     {
         DatabaseInterface musicDb;
@@ -5224,6 +5542,61 @@ private Q_SLOTS:
         QCOMPARE(allGenresData[3].title(), QStringLiteral("genre4"));
     }
 
+    void searchTracksAndAlbums()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        if (!musicDb.canSearchData(ElisaUtils::Track)) {
+            QSKIP("SQLite is built without FTS5");
+        }
+
+        QVERIFY(musicDb.canSearchData(ElisaUtils::Album));
+        QVERIFY(!musicDb.canSearchData(ElisaUtils::Genre));
+
+        musicDb.insertTracksList(mNewTracks);
+
+        musicDbTrackAddedSpy.wait(300);
+
+        QCOMPARE(musicDbTrackAddedSpy.count(), 1);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        const auto matchingTracks = musicDb.databaseIdsMatchingSearch(ElisaUtils::Track, QStringLiteral("TRACK1 alb"));
+
+        QVERIFY(!matchingTracks.isEmpty());
+        for (const auto &oneTrack : musicDb.allTracksData()) {
+            QCOMPARE(matchingTracks.contains(oneTrack.databaseId()), oneTrack.title() == QStringLiteral("track1"));
+        }
+
+        const auto matchingAlbums = musicDb.databaseIdsMatchingSearch(ElisaUtils::Album, QStringLiteral("album3"));
+
+        QVERIFY(!matchingAlbums.isEmpty());
+        for (const auto &oneAlbum : musicDb.allAlbumsData()) {
+            QCOMPARE(matchingAlbums.contains(oneAlbum.databaseId()), oneAlbum.title() == QStringLiteral("album3"));
+        }
+
+        QVERIFY(musicDb.databaseIdsMatchingSearch(ElisaUtils::Track, QStringLiteral("\" - ")).isEmpty());
+        QVERIFY(!DatabaseInterface::isSearchableText(QStringLiteral("\" - ")));
+        QVERIFY(DatabaseInterface::isSearchableText(QStringLiteral("- track1")));
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto removedTracks = QList<QUrl>{};
+        for (const auto oneTrackId : matchingTracks) {
+            removedTracks.push_back(musicDb.trackDataFromDatabaseId(oneTrackId).resourceURI());
+        }
+
+        musicDb.removeTracksList(removedTracks);
+
+        QVERIFY(musicDbTrackRemovedSpy.count() > 0);
+        QVERIFY(musicDb.databaseIdsMatchingSearch(ElisaUtils::Track, QStringLiteral("track1")).isEmpty());
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void clearDataTest()
     {
         DatabaseInterface musicDb;
@@ -6077,6 +6450,165 @@ private Q_SLOTS:
 
         databaseFile.remove();
     }
+
+    void fetchArtistsCoversWithConstantQueriesCount()
+    {
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(testConnectionName);
+
+        // each artist has more albums than the four covers shown for one artist
+        auto newArtistsTracks = [](int firstArtist, int artistsCount) {
+            auto newTracks = DataTypes::ListTrackDataType();
+
+            for (int artistIndex = firstArtist; artistIndex < firstArtist + artistsCount; ++artistIndex) {
+                for (int albumIndex = 0; albumIndex < 6; ++albumIndex) {
+                    const auto trackPath = QStringLiteral("/artist%1/$%2").arg(artistIndex).arg(albumIndex);
+                    const auto albumTitle = QStringLiteral("artist%1 album%2").arg(artistIndex).arg(albumIndex);
+
+                    newTracks.push_back(DataTypes::TrackDataType{true, trackPath, QStringLiteral("0"), QStringLiteral("track%1").arg(albumIndex),
+                            QStringLiteral("artist%1").arg(artistIndex), albumTitle, QStringLiteral("artist%1").arg(artistIndex),
+                            1, 1, QTime::fromMSecsSinceStartOfDay(albumIndex + 1), {QUrl::fromLocalFile(trackPath)},
+                            QDateTime::fromMSecsSinceEpoch(albumIndex + 1),
+                            {QUrl::fromLocalFile(albumTitle)}, 5, true,
+                            QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+                }
+            }
+
+            return newTracks;
+        };
+
+        musicDb.insertTracksList(newArtistsTracks(0, 10));
+
+        auto queriesCountBefore = musicDb.executedQueriesCount();
+        const auto fewArtists = musicDb.allArtistsData();
+        const auto fewArtistsQueriesCount = musicDb.executedQueriesCount() - queriesCountBefore;
+
+        musicDb.insertTracksList(newArtistsTracks(10, 190));
+
+        queriesCountBefore = musicDb.executedQueriesCount();
+        const auto manyArtists = musicDb.allArtistsData();
+        const auto manyArtistsQueriesCount = musicDb.executedQueriesCount() - queriesCountBefore;
+
+        QCOMPARE(fewArtists.count(), 10);
+        QCOMPARE(manyArtists.count(), 200);
+        QVERIFY(fewArtistsQueriesCount > 0);
+        QCOMPARE(manyArtistsQueriesCount, fewArtistsQueriesCount);
+
+        for (const auto &oneArtist : manyArtists) {
+            const auto covers = oneArtist[DataTypes::MultipleImageUrlsRole].toList();
+            QCOMPARE(covers.count(), 4);
+            QVERIFY(covers.at(0).toUrl().toLocalFile().contains(QStringLiteral("%1 album").arg(oneArtist.title())));
+            QCOMPARE(oneArtist[DataTypes::ImageUrlRole].toUrl(), covers.at(0).toUrl());
+        }
+
+        QCOMPARE(musicDbArtistAddedSpy.count(), 2);
+        const auto addedArtists = musicDbArtistAddedSpy.constLast().at(0).value<DataTypes::ListArtistDataType>();
+        QCOMPARE(addedArtists.count(), 190);
+        for (const auto &oneArtist : addedArtists) {
+            QCOMPARE(oneArtist[DataTypes::MultipleImageUrlsRole].toList().count(), 4);
+        }
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void fetchInsertedTracksWithConstantQueriesCount()
+    {
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(testConnectionName);
+
+        // each batch has its own artists, albums, genre, composer and lyricist, only their count differs
+        auto newBatchTracks = [](int batchIndex, int tracksCount) {
+            auto newTracks = DataTypes::ListTrackDataType();
+            newTracks.reserve(tracksCount);
+
+            for (int i = 0; i < tracksCount; ++i) {
+                const auto trackPath = QStringLiteral("/batch%1/$%2").arg(batchIndex).arg(i);
+                const auto albumTitle = QStringLiteral("batch%1 album%2").arg(batchIndex).arg(i / 10);
+                const auto artistName = QStringLiteral("batch%1 artist%2").arg(batchIndex).arg(i % 50);
+
+                newTracks.push_back(DataTypes::TrackDataType{true, trackPath, QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                        artistName, albumTitle, artistName,
+                        i % 10 + 1, 1, QTime::fromMSecsSinceStartOfDay(i + 1), {QUrl::fromLocalFile(trackPath)},
+                        QDateTime::fromMSecsSinceEpoch(i + 1),
+                        {QUrl::fromLocalFile(albumTitle)}, 5, true,
+                        QStringLiteral("batch%1 genre").arg(batchIndex), QStringLiteral("batch%1 composer").arg(batchIndex),
+                        QStringLiteral("batch%1 lyricist").arg(batchIndex), false});
+            }
+
+            return newTracks;
+        };
+
+        musicDb.insertTracksList(newBatchTracks(0, 100));
+        const auto smallBatchQueriesCount = musicDb.insertedDataFetchQueriesCount();
+
+        musicDb.insertTracksList(newBatchTracks(1, 1000));
+        const auto bigBatchQueriesCount = musicDb.insertedDataFetchQueriesCount();
+
+        QCOMPARE(musicDbTrackAddedSpy.count(), 2);
+        QCOMPARE(musicDbTrackAddedSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 100);
+        QCOMPARE(musicDbTrackAddedSpy.at(1).at(0).value<DataTypes::ListTrackDataType>().count(), 1000);
+        QVERIFY(smallBatchQueriesCount > 0);
+        QCOMPARE(bigBatchQueriesCount, smallBatchQueriesCount);
+
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
+
+    void benchmarkInsertTracksList_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        QTest::newRow("100 tracks") << 100;
+        QTest::newRow("1000 tracks") << 1000;
+        QTest::newRow("5000 tracks") << 5000;
+    }
+
+    void benchmarkInsertTracksList()
+    {
+        QFETCH(int, tracksCount);
+
+        DatabaseInterface musicDb;
+
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.init(testConnectionName);
+
+        int batchIndex = 0;
+
+        // each batch adds new tracks spread over new albums: the new tracks and albums are fetched back in a few queries
+        QBENCHMARK {
+            auto newTracks = DataTypes::ListTrackDataType();
+            newTracks.reserve(tracksCount);
+
+            for (int i = 0; i < tracksCount; ++i) {
+                const auto trackPath = QStringLiteral("/batch%1/$%2").arg(batchIndex).arg(i);
+                const auto albumTitle = QStringLiteral("batch%1 album%2").arg(batchIndex).arg(i / 10);
+
+                newTracks.push_back(DataTypes::TrackDataType{true, trackPath, QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                        QStringLiteral("artist%1").arg(i % 50), albumTitle, QStringLiteral("artist%1").arg(i % 50),
+                        i % 10 + 1, 1, QTime::fromMSecsSinceStartOfDay(i + 1), {QUrl::fromLocalFile(trackPath)},
+                        QDateTime::fromMSecsSinceEpoch(i + 1),
+                        {QUrl::fromLocalFile(albumTitle)}, 5, true,
+                        QStringLiteral("genre1"), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+            }
+
+            musicDb.insertTracksList(newTracks);
+
+            ++batchIndex;
+        }
+
+        QCOMPARE(musicDbTrackAddedSpy.count(), batchIndex);
+        QCOMPARE(musicDbTrackAddedSpy.constLast().at(0).value<DataTypes::ListTrackDataType>().count(), tracksCount);
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(DatabaseInterfaceTests)
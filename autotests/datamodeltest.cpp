@@ -35,6 +35,25 @@ public:
     {
     }
 
+private:
+
+    static DataTypes::ListTrackDataType buildTracks(int tracksCount)
+    {
+        auto allTracks = DataTypes::ListTrackDataType{};
+        allTracks.reserve(tracksCount);
+        for (int i = 0; i < tracksCount; ++i) {
+            allTracks.push_back(DataTypes::TrackDataType{true, QStringLiteral("$%1").arg(i), QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                    QStringLiteral("artist%1").arg(i % 500), QStringLiteral("album%1").arg(i / 10), QStringLiteral("artist%1").arg(i % 500),
+                    i % 10 + 1, 1, QTime::fromMSecsSinceStartOfDay(1000 * (i % 600)), QUrl::fromLocalFile(QStringLiteral("/music/$%1").arg(i)),
+                    QDateTime::fromMSecsSinceEpoch(i),
+                    QUrl::fromLocalFile(QStringLiteral("album%1").arg(i / 10)), 0, true,
+                    {}, QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+            allTracks.back()[DataTypes::DatabaseIdRole] = i + 1;
+        }
+
+        return allTracks;
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -1558,6 +1577,80 @@ private Q_SLOTS:
         QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 2);
         QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 2);
     }
+
+    void benchmarkModifyTracks()
+    {
+        constexpr auto tracksCount = 200000;
+        constexpr auto modifiedTracksCount = 10000;
+
+        const auto allTracks = buildTracks(tracksCount);
+
+        auto modifiedTracks = DataTypes::ListTrackDataType{};
+        modifiedTracks.reserve(modifiedTracksCount);
+        for (int i = 0; i < modifiedTracksCount; ++i) {
+            auto modifiedTrack = allTracks[(i * 7919) % tracksCount];
+            modifiedTrack[DataTypes::RatingRole] = 5;
+            modifiedTracks.push_back(modifiedTrack);
+        }
+
+        QBENCHMARK {
+            DataModel tracksModel;
+            tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+            QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+            tracksModel.tracksAdded(allTracks);
+            QCOMPARE(tracksModel.rowCount(), tracksCount);
+
+            for (const auto &oneTrack : std::as_const(modifiedTracks)) {
+                tracksModel.trackModified(oneTrack);
+            }
+
+            QCOMPARE(dataChangedSpy.count(), modifiedTracksCount);
+        }
+    }
+
+    void benchmarkRemoveTracksNearTop()
+    {
+        constexpr auto tracksCount = 200000;
+        constexpr auto removedTracksCount = 10000;
+
+        const auto allTracks = buildTracks(tracksCount);
+
+        QBENCHMARK {
+            DataModel tracksModel;
+            tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+            QSignalSpy rowsRemovedSpy(&tracksModel, &DataModel::rowsRemoved);
+            QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+            tracksModel.tracksAdded(allTracks);
+            QCOMPARE(tracksModel.rowCount(), tracksCount);
+
+            // every other track of the first rows is removed, each removal shifting all the rows after it
+            for (int i = 0; i < removedTracksCount; ++i) {
+                tracksModel.trackRemoved(2 * i + 1);
+            }
+
+            QCOMPARE(rowsRemovedSpy.count(), removedTracksCount);
+            QCOMPARE(rowsRemovedSpy.constLast().at(1).toInt(), removedTracksCount - 1);
+            QCOMPARE(tracksModel.rowCount(), tracksCount - removedTracksCount);
+
+            auto lastTrack = allTracks.constLast();
+            lastTrack[DataTypes::RatingRole] = 5;
+            tracksModel.trackModified(lastTrack);
+            auto firstKeptTrack = allTracks.at(1);
+            firstKeptTrack[DataTypes::RatingRole] = 5;
+            tracksModel.trackModified(firstKeptTrack);
+            tracksModel.trackModified(allTracks.constFirst());
+
+            QCOMPARE(dataChangedSpy.count(), 2);
+            QCOMPARE(dataChangedSpy.at(0).at(0).value<QModelIndex>().row(), tracksCount - removedTracksCount - 1);
+            QCOMPARE(dataChangedSpy.at(1).at(0).value<QModelIndex>().row(), 0);
+            QCOMPARE(tracksModel.data(tracksModel.index(removedTracksCount, 0), DataTypes::DatabaseIdRole).toULongLong(),
+                     qulonglong{2 * removedTracksCount + 1});
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
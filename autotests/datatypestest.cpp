@@ -0,0 +1,215 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "datatypes.h"
+
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QTime>
+#include <QUrl>
+
+#include <QTest>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace Qt::Literals::StringLiterals;
+
+class DataTypesTests: public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DataTypesTests(QObject *aParent = nullptr) : QObject(aParent)
+    {
+    }
+
+private:
+
+    static DataTypes::ListTrackDataType buildTracks(int tracksCount)
+    {
+        auto result = DataTypes::ListTrackDataType{};
+        result.reserve(tracksCount);
+
+        for (int i = 0; i < tracksCount; ++i) {
+            result.push_back(DataTypes::TrackDataType{true, QStringLiteral("$%1").arg(i), QStringLiteral("0"), QStringLiteral("track%1").arg(i),
+                    QStringLiteral("artist%1").arg(i % 500), QStringLiteral("album%1").arg(i / 10), QStringLiteral("artist%1").arg(i % 500),
+                    i % 10 + 1, 1, QTime::fromMSecsSinceStartOfDay(1000 * (i % 600)), QUrl::fromLocalFile(QStringLiteral("/music/$%1").arg(i)),
+                    QDateTime::fromMSecsSinceEpoch(i),
+                    QUrl::fromLocalFile(QStringLiteral("album%1").arg(i / 10)), i % 10, true,
+                    QStringLiteral("genre%1").arg(i % 20), QStringLiteral("composer1"), QStringLiteral("lyricist1"), false});
+            result.back()[DataTypes::DatabaseIdRole] = i + 1;
+        }
+
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void compactRecordBehavesLikeMap()
+    {
+        auto data = DataTypes::DataType{{DataTypes::YearRole, 2020}, {DataTypes::TitleRole, QStringLiteral("title")}};
+
+        QCOMPARE(data.size(), 2);
+        QCOMPARE(data.keys(), (QList<DataTypes::ColumnsRoles>{DataTypes::TitleRole, DataTypes::YearRole}));
+        QCOMPARE(data[DataTypes::TitleRole].toString(), QStringLiteral("title"));
+        QCOMPARE(data.value(DataTypes::YearRole).toInt(), 2020);
+        QVERIFY(data.find(DataTypes::ArtistRole) == data.end());
+        QVERIFY(!std::as_const(data).value(DataTypes::ArtistRole).isValid());
+
+        data[DataTypes::ArtistRole] = QStringLiteral("artist");
+        data.insert(DataTypes::TracksCountRole, 12);
+        data.insert(DataTypes::YearRole, 2021);
+
+        QCOMPARE(data.size(), 4);
+        QCOMPARE(data.keys(), (QList<DataTypes::ColumnsRoles>{DataTypes::TitleRole, DataTypes::ArtistRole,
+                                                               DataTypes::YearRole, DataTypes::TracksCountRole}));
+        QCOMPARE(data.value(DataTypes::YearRole).toInt(), 2021);
+        QCOMPARE(data.find(DataTypes::ArtistRole).value().toString(), QStringLiteral("artist"));
+
+        const auto otherRole = static_cast<DataTypes::ColumnsRoles>(Qt::DisplayRole);
+        data[otherRole] = QStringLiteral("display");
+
+        QVERIFY(data.contains(otherRole));
+        QCOMPARE(data.size(), 5);
+        QCOMPARE(data.keys().last(), otherRole);
+
+        data.insert(DataTypes::AlbumRole, QStringLiteral("album"));
+        QCOMPARE(data.value(otherRole).toString(), QStringLiteral("display"));
+        QCOMPARE(data.value(DataTypes::AlbumRole).toString(), QStringLiteral("album"));
+
+        auto copy = data;
+        QCOMPARE(copy, data);
+
+        copy[DataTypes::AlbumRole] = QStringLiteral("other album");
+        QVERIFY(copy != data);
+        QCOMPARE(data.value(DataTypes::AlbumRole).toString(), QStringLiteral("album"));
+
+        QCOMPARE(data.remove(DataTypes::ArtistRole), 1);
+        QCOMPARE(data.remove(DataTypes::ArtistRole), 0);
+        QCOMPARE(data.take(otherRole).toString(), QStringLiteral("display"));
+        QCOMPARE(data.keys(), (QList<DataTypes::ColumnsRoles>{DataTypes::TitleRole, DataTypes::AlbumRole,
+                                                               DataTypes::YearRole, DataTypes::TracksCountRole}));
+
+        auto keysCount = 0;
+        for (auto it = data.constKeyValueBegin(); it != data.constKeyValueEnd(); ++it) {
+            QCOMPARE((*it).second, data.value((*it).first));
+            ++keysCount;
+        }
+        QCOMPARE(keysCount, 4);
+
+        data.clear();
+        QVERIFY(data.isEmpty());
+        QVERIFY(data.begin() == data.end());
+    }
+
+    void internedMetaDataShareStorage()
+    {
+        auto firstTrack = DataTypes::TrackDataType{};
+        firstTrack[DataTypes::ArtistRole] = QString{u"artist"_s + QString::number(1)};
+        firstTrack[DataTypes::AlbumRole] = QString{u"album"_s + QString::number(1)};
+        firstTrack[DataTypes::TitleRole] = QString{u"title"_s + QString::number(1)};
+
+        auto secondTrack = DataTypes::TrackDataType{};
+        secondTrack[DataTypes::ArtistRole] = QString{u"artist"_s + QString::number(1)};
+        secondTrack[DataTypes::AlbumRole] = QString{u"album"_s + QString::number(1)};
+        secondTrack[DataTypes::TitleRole] = QString{u"title"_s + QString::number(1)};
+
+        QVERIFY(firstTrack.artist().constData() != secondTrack.artist().constData());
+
+        firstTrack.internMetaDataStrings();
+        secondTrack.internMetaDataStrings();
+
+        QCOMPARE(firstTrack.artist(), u"artist1"_s);
+        QCOMPARE(secondTrack.album(), u"album1"_s);
+        QCOMPARE(firstTrack.artist().constData(), secondTrack.artist().constData());
+        QCOMPARE(firstTrack.album().constData(), secondTrack.album().constData());
+        QVERIFY(firstTrack.title().constData() != secondTrack.title().constData());
+    }
+
+    void compactRecordUsesLessMemoryThanMap()
+    {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+        const auto recordsCount = 10000;
+
+        // values are implicitly shared with the model track: only the memory of the records themselves is measured
+        const auto modelTrack = buildTracks(1).constFirst();
+
+        auto compactRecords = QList<DataTypes::TrackDataType>{};
+        compactRecords.reserve(recordsCount);
+        auto mapRecords = QList<QMap<DataTypes::ColumnsRoles, QVariant>>{};
+        mapRecords.reserve(recordsCount);
+
+        const auto heapBeforeCompactRecords = mallinfo2().uordblks;
+
+        for (int i = 0; i < recordsCount; ++i) {
+            auto oneRecord = DataTypes::TrackDataType{};
+            for (auto it = modelTrack.constKeyValueBegin(); it != modelTrack.constKeyValueEnd(); ++it) {
+                oneRecord[(*it).first] = (*it).second;
+            }
+            compactRecords.push_back(std::move(oneRecord));
+        }
+
+        const auto heapBeforeMapRecords = mallinfo2().uordblks;
+
+        for (int i = 0; i < recordsCount; ++i) {
+            auto oneRecord = QMap<DataTypes::ColumnsRoles, QVariant>{};
+            for (auto it = modelTrack.constKeyValueBegin(); it != modelTrack.constKeyValueEnd(); ++it) {
+                oneRecord[(*it).first] = (*it).second;
+            }
+            mapRecords.push_back(std::move(oneRecord));
+        }
+
+        const auto heapAfterMapRecords = mallinfo2().uordblks;
+
+        const auto compactBytesPerRecord = (heapBeforeMapRecords - heapBeforeCompactRecords) / recordsCount;
+        const auto mapBytesPerRecord = (heapAfterMapRecords - heapBeforeMapRecords) / recordsCount;
+
+        qInfo() << modelTrack.size() << "roles per track:" << compactBytesPerRecord << "bytes per compact record,"
+                << mapBytesPerRecord << "bytes per QMap record";
+
+        QCOMPARE(compactRecords.constLast(), modelTrack);
+        QCOMPARE(mapRecords.constLast().size(), modelTrack.size());
+        QVERIFY2(compactBytesPerRecord < mapBytesPerRecord,
+                 qPrintable(u"%1 bytes per compact record, %2 bytes per QMap record"_s.arg(compactBytesPerRecord).arg(mapBytesPerRecord)));
+#else
+        QSKIP("heap usage is only measured with the GNU C library");
+#endif
+    }
+
+    void benchmarkBuildTracks()
+    {
+        QBENCHMARK {
+            const auto allTracks = buildTracks(100000);
+            QCOMPARE(allTracks.size(), 100000);
+        }
+    }
+
+    void benchmarkReadTracksRoles()
+    {
+        const auto allTracks = buildTracks(100000);
+
+        qulonglong checksum = 0;
+
+        QBENCHMARK {
+            checksum = 0;
+            for (const auto &oneTrack : allTracks) {
+                checksum += oneTrack.databaseId() + oneTrack.title().size() + oneTrack.artist().size() +
+                        oneTrack.album().size() + oneTrack.duration().second() + oneTrack.rating();
+            }
+        }
+
+        QVERIFY(checksum != 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(DataTypesTests)
+
+
+#include "datatypestest.moc"
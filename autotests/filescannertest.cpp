@@ -5,11 +5,14 @@
  */
 
 #include "filescanner.h"
+#include "coverfilecache.h"
 #include "config-upnp-qt.h"
 
 #include <QObject>
 #include <QList>
 #include <QUrl>
+#include <QFile>
+#include <QTemporaryDir>
 
 
 #include <QTest>
@@ -99,6 +102,53 @@ private Q_SLOTS:
         QVERIFY(!fileScanner.searchForCoverFile(mTestTracksForDirectory.at(8)).isEmpty());
     }
 
+    void testCoverFileCacheInvalidation()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        CoverFileCache coverFileCache;
+        FileScanner fileScanner;
+        fileScanner.setCoverFileCache(&coverFileCache);
+
+        const auto trackFileName = musicDirectory.filePath(QStringLiteral("not_existing.ogg"));
+        QVERIFY(fileScanner.searchForCoverFile(trackFileName).isEmpty());
+
+        QVERIFY(QFile::copy(mTestTracksForDirectory.at(2).section(QLatin1Char('/'), 0, -2) + QStringLiteral("/folder.jpg"),
+                            musicDirectory.filePath(QStringLiteral("folder.jpg"))));
+
+        QVERIFY(fileScanner.searchForCoverFile(trackFileName).isEmpty());
+
+        coverFileCache.invalidate(musicDirectory.path());
+
+        const auto newCover = fileScanner.searchForCoverFile(trackFileName);
+        QCOMPARE(newCover.fileName(), QStringLiteral("folder.jpg"));
+
+        FileScanner otherFileScanner;
+        otherFileScanner.setCoverFileCache(&coverFileCache);
+        QCOMPARE(otherFileScanner.searchForCoverFile(trackFileName), newCover);
+    }
+
+    void testMimeTypeOfModifiedFile()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        // without extension, the type of the file is detected from its content
+        const auto trackFileName = musicDirectory.filePath(QStringLiteral("track"));
+        QVERIFY(QFile::copy(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg"), trackFileName));
+
+        FileScanner fileScanner;
+        QVERIFY(fileScanner.shouldScanFile(trackFileName));
+
+        QFile trackFile(trackFileName);
+        QVERIFY(trackFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QVERIFY(trackFile.write("not a music file\n") > 0);
+        trackFile.close();
+
+        QVERIFY(!fileScanner.shouldScanFile(trackFileName));
+    }
+
     void benchmarkFileScan()
     {
         FileScanner fileScanner;
@@ -111,6 +161,29 @@ private Q_SLOTS:
         }
     }
 
+    void benchmarkFileScanWithEmbeddedCover_data()
+    {
+        QTest::addColumn<QString>("fileName");
+
+        QTest::newRow("ogg") << mTestTracksForMetaData.at(0);
+        QTest::newRow("flac") << mTestTracksForMetaData.at(1);
+        QTest::newRow("mp3") << mTestTracksForMetaData.at(2);
+    }
+
+    void benchmarkFileScanWithEmbeddedCover()
+    {
+        QFETCH(QString, fileName);
+
+        FileScanner fileScanner;
+        const auto fileUrl = QUrl::fromLocalFile(fileName);
+
+        QBENCHMARK {
+            QVERIFY(fileScanner.shouldScanFile(fileName));
+            auto scannedTrack = fileScanner.scanOneFile(fileUrl);
+            QVERIFY(scannedTrack.hasEmbeddedCover());
+        }
+    }
+
     void benchmarkCoverInDirectory()
     {
         FileScanner fileScanner;
@@ -0,0 +1,191 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "abstractfile/filesystemwatcherbackend.h"
+
+#include <QObject>
+#include <QString>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include <algorithm>
+#include <memory>
+
+using namespace Qt::Literals::StringLiterals;
+
+class FileSystemWatcherBackendTests: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    static bool spyContains(const QSignalSpy &spy, const QString &path)
+    {
+        return std::any_of(spy.cbegin(), spy.cend(), [&path](const auto &oneSignal) {
+            return oneSignal.at(0).toString() == path;
+        });
+    }
+
+    static bool writeFile(const QString &fileName, const QByteArray &content)
+    {
+        QFile oneFile(fileName);
+        if (!oneFile.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+
+        return oneFile.write(content) == content.size();
+    }
+
+private Q_SLOTS:
+
+    void createFile()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QSignalSpy directoryChangedSpy(watcher.get(), &FileSystemWatcherBackend::directoryChanged);
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+
+        QVERIFY(writeFile(musicDirectory.filePath(u"track1.ogg"_s), "1"));
+
+        QTRY_VERIFY(spyContains(directoryChangedSpy, musicDirectory.path()));
+    }
+
+    void modifyFile()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto watchedFile = musicDirectory.filePath(u"track1.ogg"_s);
+        const auto otherFile = musicDirectory.filePath(u"track2.ogg"_s);
+        QVERIFY(writeFile(watchedFile, "1"));
+        QVERIFY(writeFile(otherFile, "2"));
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QSignalSpy fileChangedSpy(watcher.get(), &FileSystemWatcherBackend::fileChanged);
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+        QVERIFY(watcher->addFile(watchedFile));
+
+        QVERIFY(writeFile(otherFile, "22"));
+        QVERIFY(writeFile(watchedFile, "11"));
+
+        QTRY_VERIFY(spyContains(fileChangedSpy, watchedFile));
+        QVERIFY(!spyContains(fileChangedSpy, otherFile));
+    }
+
+    void deleteFile()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        const auto watchedFile = musicDirectory.filePath(u"track1.ogg"_s);
+        QVERIFY(writeFile(watchedFile, "1"));
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QSignalSpy directoryChangedSpy(watcher.get(), &FileSystemWatcherBackend::directoryChanged);
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+        QVERIFY(watcher->addFile(watchedFile));
+
+        QVERIFY(QFile::remove(watchedFile));
+
+        QTRY_VERIFY(spyContains(directoryChangedSpy, musicDirectory.path()));
+    }
+
+    void moveFileInAndOut()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QTemporaryDir otherDirectory;
+        QVERIFY(otherDirectory.isValid());
+
+        const auto outsideFile = otherDirectory.filePath(u"track1.ogg"_s);
+        const auto insideFile = musicDirectory.filePath(u"track1.ogg"_s);
+        QVERIFY(writeFile(outsideFile, "1"));
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QSignalSpy directoryChangedSpy(watcher.get(), &FileSystemWatcherBackend::directoryChanged);
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+
+        QVERIFY(QFile::rename(outsideFile, insideFile));
+
+        QTRY_VERIFY(spyContains(directoryChangedSpy, musicDirectory.path()));
+
+        QVERIFY(watcher->addFile(insideFile));
+        directoryChangedSpy.clear();
+
+        QVERIFY(QFile::rename(insideFile, outsideFile));
+
+        QTRY_VERIFY(spyContains(directoryChangedSpy, musicDirectory.path()));
+        QVERIFY(!spyContains(directoryChangedSpy, otherDirectory.path()));
+    }
+
+    void watchDirectoriesOnly()
+    {
+#if !defined Q_OS_LINUX || defined Q_OS_ANDROID
+        QSKIP("files only share the watch of their directory with the inotify backend");
+#endif
+
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+
+        for (int i = 0; i < 10; ++i) {
+            const auto oneFile = musicDirectory.filePath(u"track%1.ogg"_s.arg(i));
+            QVERIFY(writeFile(oneFile, "1"));
+            QVERIFY(watcher->addFile(oneFile));
+        }
+
+        QCOMPARE(watcher->watchesCount(), 1);
+    }
+
+    void watchesLimit()
+    {
+        QTemporaryDir musicDirectory;
+        QVERIFY(musicDirectory.isValid());
+        QVERIFY(QDir(musicDirectory.path()).mkdir(u"album1"_s));
+        QVERIFY(QDir(musicDirectory.path()).mkdir(u"album2"_s));
+
+        std::unique_ptr<FileSystemWatcherBackend> watcher{FileSystemWatcherBackend::create()};
+
+        QSignalSpy directoryChangedSpy(watcher.get(), &FileSystemWatcherBackend::directoryChanged);
+
+        watcher->setMaximumWatches(2);
+
+        QVERIFY(watcher->addDirectory(musicDirectory.path()));
+        QVERIFY(watcher->addDirectory(musicDirectory.filePath(u"album1"_s)));
+        QVERIFY(!watcher->addDirectory(musicDirectory.filePath(u"album2"_s)));
+
+        // watching an already watched directory again does not need a new watch
+        QVERIFY(watcher->addDirectory(musicDirectory.filePath(u"album1"_s)));
+        QCOMPARE(watcher->watchesCount(), 2);
+
+        // the directories watched before reaching the limit are still watched
+        QVERIFY(writeFile(musicDirectory.filePath(u"album1/track1.ogg"_s), "1"));
+
+        QTRY_VERIFY(spyContains(directoryChangedSpy, musicDirectory.filePath(u"album1"_s)));
+    }
+};
+
+QTEST_GUILESS_MAIN(FileSystemWatcherBackendTests)
+
+
+#include "filesystemwatcherbackendtest.moc"
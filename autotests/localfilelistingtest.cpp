@@ -21,11 +21,14 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
 
 #include <QSignalSpy>
 #include <QTest>
 
 #include <algorithm>
+#include <limits>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -37,6 +40,8 @@ private Q_SLOTS:
 
     void initTestCase()
     {
+        QStandardPaths::setTestModeEnabled(true);
+
         qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
         qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
         qRegisterMetaType<QList<qlonglong>>("QList<qlonglong>");
@@ -652,6 +657,278 @@ private Q_SLOTS:
         QCOMPARE(newTracks.count(), 2);
         QCOMPARE(removedTracks.count(), 1);
     }
+
+    void scanManifestSkipsUnchangedDirectories()
+    {
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music"_s;
+
+        const QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/music4"_s;
+
+        const QString musicPath = musicParentPath + u"/data/innerData"_s;
+
+        const QString trackOggPath = musicPath + u"/test.ogg"_s;
+
+        const QString trackMp3Path = musicPath + u"/test.mp3"_s;
+
+        const QString manifestPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/scanManifest.dat"_s;
+
+        QDir musicParentDirectory(musicParentPath);
+        QVERIFY(musicParentDirectory.removeRecursively());
+        QFile::remove(manifestPath);
+
+        QVERIFY(QDir().mkpath(musicPath));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, trackOggPath));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.mp3"_s, trackMp3Path));
+
+        QHash<QUrl, QDateTime> indexedTracks;
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.setScanManifestFileName(manifestPath);
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks({});
+
+            for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+                const auto newTracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+                for (const auto &oneTrack : newTracks) {
+                    indexedTracks[oneTrack.resourceURI()] = oneTrack.fileModificationTime();
+                }
+            }
+
+            QCOMPARE(indexedTracks.size(), 2);
+            QVERIFY(QFile::exists(manifestPath));
+        }
+
+        // rewriting a file in place changes its modification time but not the one of its directory:
+        // it is only found again if the directory is listed again
+        QTest::qWait(50);
+        {
+            QFile trackMp3File(trackMp3Path);
+            QVERIFY(trackMp3File.open(QIODevice::ReadWrite));
+            const auto trackMp3Content = trackMp3File.readAll();
+            QVERIFY(trackMp3File.seek(0));
+            QCOMPARE(trackMp3File.write(trackMp3Content), trackMp3Content.size());
+        }
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+            myListing.setScanManifestFileName(manifestPath);
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(indexedTracks);
+
+            QCOMPARE(tracksListSpy.count(), 0);
+            QCOMPARE(removedTracksListSpy.count(), 0);
+        }
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(indexedTracks);
+
+            QCOMPARE(tracksListSpy.count(), 1);
+
+            const auto newTracks = tracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+
+            QCOMPARE(newTracks.count(), 1);
+            QCOMPARE(newTracks.at(0).resourceURI(), QUrl::fromLocalFile(trackMp3Path));
+        }
+
+        indexedTracks[QUrl::fromLocalFile(trackMp3Path)] = QFileInfo(trackMp3Path).metadataChangeTime();
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+
+            auto partialIndexedTracks = indexedTracks;
+            partialIndexedTracks.remove(QUrl::fromLocalFile(trackOggPath));
+
+            myListing.setScanManifestFileName(manifestPath);
+            myListing.init();
+            myListing.setAllRootPaths({musicParentPath});
+            myListing.setIndexedTracks(partialIndexedTracks);
+
+            QCOMPARE(tracksListSpy.count(), 1);
+            QCOMPARE(removedTracksListSpy.count(), 0);
+
+            const auto newTracks = tracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+
+            QCOMPARE(newTracks.count(), 1);
+            QCOMPARE(newTracks.at(0).resourceURI(), QUrl::fromLocalFile(trackOggPath));
+        }
+    }
+
+    void coalesceFileSystemChanges()
+    {
+        LocalFileListing myListing;
+
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + u"/music"_s;
+
+        const QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/music5"_s;
+
+        const QString musicPath = musicParentPath + u"/data/innerData"_s;
+
+        QDir musicParentDirectory(musicParentPath);
+        QVERIFY(musicParentDirectory.removeRecursively());
+        QVERIFY(QDir().mkpath(musicPath));
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy indexingStartedSpy(&myListing, &LocalFileListing::indexingStarted);
+        QSignalSpy errorWatchingFileSystemChangesSpy(&myListing, &LocalFileListing::errorWatchingFileSystemChanges);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 0);
+        QCOMPARE(indexingStartedSpy.count(), 1);
+
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.ogg"_s, musicPath + u"/test.ogg"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.mp3"_s, musicPath + u"/test.mp3"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/test.m4a"_s, musicPath + u"/test.m4a"_s));
+        QVERIFY(QFile::copy(musicOriginPath + u"/cover.jpg"_s, musicPath + u"/cover.jpg"_s));
+
+        auto addedFilesWorking = tracksListSpy.wait();
+
+        if (!addedFilesWorking && errorWatchingFileSystemChangesSpy.count()) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QVERIFY(addedFilesWorking);
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(indexingStartedSpy.count(), 2);
+        QCOMPARE(tracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 3);
+
+        QVERIFY(QDir(musicPath).removeRecursively());
+
+        QVERIFY(removedTracksListSpy.wait());
+
+        QCOMPARE(removedTracksListSpy.count(), 1);
+        QCOMPARE(removedTracksListSpy.at(0).at(0).value<QList<QUrl>>().count(), 3);
+    }
+
+    void benchmarkRescanFlatDirectory_data()
+    {
+        QTest::addColumn<int>("filesCount");
+
+        QTest::newRow("1000 files") << 1000;
+        QTest::newRow("10000 files") << 10000;
+        QTest::newRow("50000 files") << 50000;
+    }
+
+    void benchmarkRescanFlatDirectory()
+    {
+        QFETCH(int, filesCount);
+
+        const QString flatMusicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/flatMusic"_s;
+
+        QHash<QUrl, QDateTime> indexedTracks;
+        QVERIFY(createFlatDirectory(flatMusicPath, filesCount, indexedTracks));
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({QFileInfo(flatMusicPath).canonicalFilePath()});
+
+        QBENCHMARK {
+            myListing.setIndexedTracks(indexedTracks);
+        }
+
+        QCOMPARE(tracksListSpy.count(), 0);
+
+        QVERIFY(QDir(flatMusicPath).removeRecursively());
+    }
+
+    void rescanFlatDirectoryScalesLinearly()
+    {
+        const QString flatMusicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + u"/flatMusic"_s;
+
+        auto bestRescanTime = [&flatMusicPath](int filesCount) {
+            QHash<QUrl, QDateTime> indexedTracks;
+            if (!createFlatDirectory(flatMusicPath, filesCount, indexedTracks)) {
+                return qint64{-1};
+            }
+
+            LocalFileListing myListing;
+
+            myListing.init();
+            myListing.setAllRootPaths({QFileInfo(flatMusicPath).canonicalFilePath()});
+
+            auto bestTime = std::numeric_limits<qint64>::max();
+            for (int i = 0; i < 3; ++i) {
+                QElapsedTimer rescanTimer;
+                rescanTimer.start();
+                myListing.setIndexedTracks(indexedTracks);
+                bestTime = std::min(bestTime, rescanTimer.nsecsElapsed());
+            }
+
+            QDir(flatMusicPath).removeRecursively();
+
+            return bestTime;
+        };
+
+        const auto smallRescanTime = bestRescanTime(2000);
+        const auto largeRescanTime = bestRescanTime(8000);
+
+        QVERIFY(smallRescanTime > 0);
+        QVERIFY(largeRescanTime > 0);
+
+        qInfo() << "rescan of 2000 files" << smallRescanTime / 1000 << "us, of 8000 files" << largeRescanTime / 1000 << "us";
+
+        // four times more files: a linear rescan takes about four times longer, a quadratic one sixteen times
+        QVERIFY2(largeRescanTime < 8 * smallRescanTime,
+                 qPrintable(u"%1 ns for 2000 files, %2 ns for 8000 files"_s.arg(smallRescanTime).arg(largeRescanTime)));
+    }
+
+private:
+
+    /**
+     * Create a directory of empty tracks all indexed with a modification time in the future,
+     * plus one indexed track missing from the directory: a rescan lists the directory and only
+     * checks its files against the index
+     */
+    static bool createFlatDirectory(const QString &flatMusicPath, int filesCount, QHash<QUrl, QDateTime> &indexedTracks)
+    {
+        QDir flatMusicDirectory(flatMusicPath);
+        if (!flatMusicDirectory.removeRecursively() || !flatMusicDirectory.mkpath(flatMusicPath)) {
+            return false;
+        }
+
+        const QString musicPath = QFileInfo(flatMusicPath).canonicalFilePath();
+
+        const auto lastModified = QDateTime::currentDateTime().addYears(1);
+        indexedTracks.reserve(filesCount + 1);
+
+        for (int i = 0; i < filesCount; ++i) {
+            const QString trackPath = musicPath + u"/track%1.ogg"_s.arg(i);
+            QFile trackFile(trackPath);
+            if (!trackFile.open(QIODevice::WriteOnly)) {
+                return false;
+            }
+            indexedTracks[QUrl::fromLocalFile(trackPath)] = lastModified;
+        }
+
+        indexedTracks[QUrl::fromLocalFile(musicPath + u"/missing.ogg"_s)] = lastModified;
+
+        return true;
+    }
 };
 
 QTEST_GUILESS_MAIN(LocalFileListingTests)
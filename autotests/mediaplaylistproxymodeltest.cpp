@@ -24,6 +24,8 @@
 #include <QTemporaryFile>
 #include <QAbstractItemModelTester>
 
+#include <algorithm>
+
 using namespace Qt::Literals::StringLiterals;
 
 using TestTrackData = QMap<MediaPlayList::ColumnsRoles, QVariant>;
@@ -122,12 +124,21 @@ void MediaPlayListProxyModelTest::init()
     connect(mListener, &TracksListener::trackHasChanged,
             mPlayList, &MediaPlayList::trackChanged,
             Qt::QueuedConnection);
+    connect(mListener, &TracksListener::tracksHaveChanged,
+            mPlayList, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(mListener, &TracksListener::tracksListAdded,
             mPlayList, &MediaPlayList::tracksListAdded,
             Qt::QueuedConnection);
     connect(mPlayList, &MediaPlayList::newEntryInList,
             mListener, &TracksListener::newEntryInList,
             Qt::QueuedConnection);
+    connect(mPlayList, &MediaPlayList::newUrlsInList,
+            mListener, &TracksListener::newUrlsInList,
+            Qt::QueuedConnection);
+    connect(mPlayList, &MediaPlayList::newTracksInList,
+            mListener, &TracksListener::newTracksInList,
+            Qt::QueuedConnection);
     connect(mPlayList, &MediaPlayList::newUrlInList,
             mListener, &TracksListener::newUrlInList,
             Qt::QueuedConnection);
@@ -339,14 +350,14 @@ void MediaPlayListProxyModelTest::enqueueAlbumCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -415,14 +426,14 @@ void MediaPlayListProxyModelTest::enqueueArtistCase()
 
     QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -490,14 +501,14 @@ void MediaPlayListProxyModelTest::enqueueMultipleAlbumsCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 3);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 3);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 2);
 
@@ -718,14 +729,14 @@ void MediaPlayListProxyModelTest::enqueueReplaceAndPlay()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 4);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 4);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 6);
-    QCOMPARE(mDataChangedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
+    QCOMPARE(mDataChangedSpy->count(), 3);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 3);
 
@@ -763,27 +774,27 @@ void MediaPlayListProxyModelTest::removeFirstTrackOfAlbum()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
     mPlayListProxyModel->removeRow(0);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 4);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 }
@@ -806,6 +817,9 @@ void MediaPlayListProxyModelTest::testSaveLoadPlayList()
     connect(&myListenerRestore, &TracksListener::trackHasChanged,
             &myPlayListRestore, &MediaPlayList::trackChanged,
             Qt::QueuedConnection);
+    connect(&myListenerRestore, &TracksListener::tracksHaveChanged,
+            &myPlayListRestore, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(&myListenerRestore, &TracksListener::tracksListAdded,
             &myPlayListRestore, &MediaPlayList::tracksListAdded,
             Qt::QueuedConnection);
@@ -815,6 +829,12 @@ void MediaPlayListProxyModelTest::testSaveLoadPlayList()
     connect(&myPlayListRestore, &MediaPlayList::newEntryInList,
             &myListenerRestore, &TracksListener::newEntryInList,
             Qt::QueuedConnection);
+    connect(&myPlayListRestore, &MediaPlayList::newUrlsInList,
+            &myListenerRestore, &TracksListener::newUrlsInList,
+            Qt::QueuedConnection);
+    connect(&myPlayListRestore, &MediaPlayList::newTracksInList,
+            &myListenerRestore, &TracksListener::newTracksInList,
+            Qt::QueuedConnection);
     connect(&myPlayListRestore, &MediaPlayList::newUrlInList,
             &myListenerRestore, &TracksListener::newUrlInList,
             Qt::QueuedConnection);
@@ -938,6 +958,9 @@ void MediaPlayListProxyModelTest::testSavePersistentState()
     connect(&myListenerRead, &TracksListener::trackHasChanged,
             &myPlayListRead, &MediaPlayList::trackChanged,
             Qt::QueuedConnection);
+    connect(&myListenerRead, &TracksListener::tracksHaveChanged,
+            &myPlayListRead, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(&myListenerRead, &TracksListener::tracksListAdded,
             &myPlayListRead, &MediaPlayList::tracksListAdded,
             Qt::QueuedConnection);
@@ -947,6 +970,12 @@ void MediaPlayListProxyModelTest::testSavePersistentState()
     connect(&myPlayListRead, &MediaPlayList::newEntryInList,
             &myListenerRead, &TracksListener::newEntryInList,
             Qt::QueuedConnection);
+    connect(&myPlayListRead, &MediaPlayList::newUrlsInList,
+            &myListenerRead, &TracksListener::newUrlsInList,
+            Qt::QueuedConnection);
+    connect(&myPlayListRead, &MediaPlayList::newTracksInList,
+            &myListenerRead, &TracksListener::newTracksInList,
+            Qt::QueuedConnection);
     connect(mDatabaseContent, &DatabaseInterface::tracksAdded,
             &myListenerRead, &TracksListener::tracksAdded);
 
@@ -1255,6 +1284,44 @@ void MediaPlayListProxyModelTest::testRestoreSettings()
     QCOMPARE(mPlayListFinishedSpy->count(), 0);
 }
 
+void MediaPlayListProxyModelTest::testRestoreDuplicatedShuffledRows()
+{
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1)}},
+                         QStringLiteral("track1"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"), QStringLiteral("album1"), 3, 3)}},
+                         QStringLiteral("track3"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track5"), QStringLiteral("artist1"), QStringLiteral("album2"), 5, 1)}},
+                         QStringLiteral("track5"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1)}},
+                         QStringLiteral("track1"), {}}}, {}, {});
+
+    QVERIFY(mDataChangedSpy->wait());
+
+    QCOMPARE(mShuffleModeChangedSpy->count(), 0);
+
+    // row 2 is given twice and row 3 never: the play list is shuffled again
+    QVariantMap settings;
+    settings[QStringLiteral("shuffleMode")] = MediaPlayListProxyModel::Shuffle::Track;
+    settings[QStringLiteral("randomMapping")] = QVariantList({QVariant(2), QVariant(0), QVariant(2), QVariant(1)});
+
+    mPlayListProxyModel->setPersistentState(settings);
+
+    QCOMPARE(mShuffleModeChangedSpy->count(), 1);
+    QCOMPARE(mPlayListProxyModel->shuffleMode(), MediaPlayListProxyModel::Shuffle::Track);
+    QCOMPARE(mPlayListProxyModel->rowCount(), 4);
+
+    auto sourceRows = QList<int>{};
+    for (int i = 0; i < mPlayListProxyModel->rowCount(); ++i) {
+        sourceRows.push_back(mPlayListProxyModel->mapRowToSource(i));
+    }
+    std::sort(sourceRows.begin(), sourceRows.end());
+    QCOMPARE(sourceRows, QList<int>({0, 1, 2, 3}));
+}
+
 void MediaPlayListProxyModelTest::testSaveAndRestoreSettings()
 {
     MediaPlayList myPlayListRestore;
@@ -1272,6 +1339,9 @@ void MediaPlayListProxyModelTest::testSaveAndRestoreSettings()
     connect(&myListenerRestore, &TracksListener::trackHasChanged,
             &myPlayListRestore, &MediaPlayList::trackChanged,
             Qt::QueuedConnection);
+    connect(&myListenerRestore, &TracksListener::tracksHaveChanged,
+            &myPlayListRestore, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(&myListenerRestore, &TracksListener::tracksListAdded,
             &myPlayListRestore, &MediaPlayList::tracksListAdded,
             Qt::QueuedConnection);
@@ -1281,6 +1351,12 @@ void MediaPlayListProxyModelTest::testSaveAndRestoreSettings()
     connect(&myPlayListRestore, &MediaPlayList::newEntryInList,
             &myListenerRestore, &TracksListener::newEntryInList,
             Qt::QueuedConnection);
+    connect(&myPlayListRestore, &MediaPlayList::newUrlsInList,
+            &myListenerRestore, &TracksListener::newUrlsInList,
+            Qt::QueuedConnection);
+    connect(&myPlayListRestore, &MediaPlayList::newTracksInList,
+            &myListenerRestore, &TracksListener::newTracksInList,
+            Qt::QueuedConnection);
     connect(mDatabaseContent, &DatabaseInterface::tracksAdded,
             &myListenerRestore, &TracksListener::tracksAdded);
 
@@ -1367,6 +1443,46 @@ void MediaPlayListProxyModelTest::testSaveAndRestoreSettings()
     QCOMPARE(myPlayListRestoreProxyModel.shuffleMode(), MediaPlayListProxyModel::Shuffle::Track);
 }
 
+void MediaPlayListProxyModelTest::testRestoreCorruptedSettings()
+{
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1)}},
+                         QStringLiteral("track1"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                          {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"), QStringLiteral("album1"), 3, 3)}},
+                         QStringLiteral("track3"), {}}}, {}, {});
+
+    QVERIFY(mDataChangedSpy->wait());
+
+    auto snapshot = qUncompress(mPlayListProxyModel->persistentState()[QStringLiteral("playListSnapshot")].toByteArray());
+    QVERIFY(!snapshot.isEmpty());
+    snapshot.chop(12);
+
+    MediaPlayList myPlayListRestore;
+    MediaPlayListProxyModel myPlayListRestoreProxyModel;
+    myPlayListRestoreProxyModel.setPlayListModel(&myPlayListRestore);
+
+    QVariantMap truncatedSettings;
+    truncatedSettings[QStringLiteral("playListSnapshot")] = qCompress(snapshot);
+    truncatedSettings[QStringLiteral("currentTrack")] = 0;
+
+    myPlayListRestoreProxyModel.setPersistentState(truncatedSettings);
+
+    QCOMPARE(myPlayListRestoreProxyModel.rowCount(), 0);
+    QVERIFY(!myPlayListRestoreProxyModel.currentTrack().isValid());
+
+    QVariantMap corruptedSettings;
+    corruptedSettings[QStringLiteral("playListSnapshot")] = QByteArrayLiteral("corrupted");
+    corruptedSettings[QStringLiteral("playList")] = QVariantList{QStringList{QStringLiteral("0"), QStringLiteral("track1"), QStringLiteral("artist1"),
+                                                                            QStringLiteral("album2"), QStringLiteral("1"), QStringLiteral("1"),
+                                                                            QString::number(ElisaUtils::Track), {}}};
+
+    myPlayListRestoreProxyModel.setPersistentState(corruptedSettings);
+
+    QCOMPARE(myPlayListRestoreProxyModel.rowCount(), 1);
+    QCOMPARE(myPlayListRestoreProxyModel.data(myPlayListRestoreProxyModel.index(0, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track1"));
+}
+
 void MediaPlayListProxyModelTest::shufflePlayList()
 {
     mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
@@ -2102,6 +2218,125 @@ void MediaPlayListProxyModelTest::remainingTracksTest()
     QCOMPARE(mPlayListProxyModel->remainingTracks(), -1);
 }
 
+void MediaPlayListProxyModelTest::tracksDurationTest()
+{
+    const auto expectedDuration = [this](int firstRow) {
+        auto duration = 0;
+        for (int row = std::max(firstRow, 0); row < mPlayListProxyModel->rowCount(); ++row) {
+            duration += mPlayListProxyModel->data(mPlayListProxyModel->index(row, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
+        }
+        return duration;
+    };
+
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1)}},
+                                   QStringLiteral("track1"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track3"), QStringLiteral("artist3"), QStringLiteral("album1"), 3, 3)}},
+                                   QStringLiteral("track3"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track4"), QStringLiteral("artist1"), QStringLiteral("album1"), 4, 4)}},
+                                   QStringLiteral("track4"), {}}}, {}, {});
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QVERIFY(mPlayListProxyModel->totalTracksDuration() > 0);
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(0));
+
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track2"), QStringLiteral("artist1"), QStringLiteral("album1"), 2, 2)}},
+                                   QStringLiteral("track2"), {}}}, {}, {});
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track5"), QStringLiteral("artist1"), QStringLiteral("album2"), 5, 1)}},
+                                   QStringLiteral("track5"), {}}}, {}, {});
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+
+    mPlayListProxyModel->skipNextTrack();
+
+    QCOMPARE(mPlayListProxyModel->currentTrackRow(), 1);
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(1));
+
+    mPlayListProxyModel->setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->moveRow(4, 2);
+
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->removeRow(mPlayListProxyModel->rowCount() - 1);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->setShuffleMode(MediaPlayListProxyModel::Shuffle::NoShuffle);
+    mPlayListProxyModel->removeRow(1);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    // rows inserted, moved or removed in the middle of the play list
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track5"), QStringLiteral("artist1"), QStringLiteral("album2"), 5, 1)}},
+                                   QStringLiteral("track5"), {}}}, ElisaUtils::AfterCurrentTrack, {});
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->moveRow(0, mPlayListProxyModel->rowCount() - 1);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->moveRow(mPlayListProxyModel->rowCount() - 1, 1);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->removeRow(1);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), expectedDuration(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), expectedDuration(mPlayListProxyModel->currentTrackRow()));
+}
+
+void MediaPlayListProxyModelTest::benchmarkShuffledEnqueue_data()
+{
+    QTest::addColumn<int>("tracksCount");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void MediaPlayListProxyModelTest::benchmarkShuffledEnqueue()
+{
+    QFETCH(int, tracksCount);
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(tracksCount);
+    for (int i = 0; i < tracksCount; ++i) {
+        newEntries.push_back({{}, QStringLiteral("track%1").arg(i), {}});
+    }
+
+    mPlayListProxyModel->setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+    mPlayListProxyModel->enqueue(newEntries, {}, {});
+
+    auto isMappingConsistent = true;
+
+    QBENCHMARK_ONCE {
+        // each new track is inserted at a random position of the shuffled play list
+        mPlayListProxyModel->enqueue(newEntries, {}, {});
+
+        for (int sourceRow = 0; sourceRow < 2 * tracksCount; ++sourceRow) {
+            isMappingConsistent = isMappingConsistent && mPlayListProxyModel->mapRowToSource(mPlayListProxyModel->mapRowFromSource(sourceRow)) == sourceRow;
+        }
+    }
+
+    QCOMPARE(mPlayListProxyModel->rowCount(), 2 * tracksCount);
+    QVERIFY(isMappingConsistent);
+}
+
 void MediaPlayListProxyModelTest::clearPlayListCase()
 {
     mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Album},
@@ -2110,15 +2345,15 @@ void MediaPlayListProxyModelTest::clearPlayListCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mTracksCountChangedSpy->count(), 3);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 1);
@@ -2166,15 +2401,15 @@ void MediaPlayListProxyModelTest::clearPlayListCase()
 
     mPlayListProxyModel->clearPlayList();
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mTracksCountChangedSpy->count(), 4);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 4);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 3);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 2);
@@ -2192,15 +2427,15 @@ void MediaPlayListProxyModelTest::undoClearPlayListCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mTracksCountChangedSpy->count(), 3);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 1);
@@ -2248,15 +2483,15 @@ void MediaPlayListProxyModelTest::undoClearPlayListCase()
 
     mPlayListProxyModel->clearPlayList();
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mTracksCountChangedSpy->count(), 4);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 4);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 3);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 2);
@@ -2267,15 +2502,15 @@ void MediaPlayListProxyModelTest::undoClearPlayListCase()
 
     mPlayListProxyModel->undoClearPlayList();
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 3);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 3);
-    QCOMPARE(mTracksCountChangedSpy->count(), 5);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 6);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 4);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 6);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 3);
@@ -2333,15 +2568,15 @@ void MediaPlayListProxyModelTest::undoReplacePlayListCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mTracksCountChangedSpy->count(), 3);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 1);
@@ -2395,14 +2630,14 @@ void MediaPlayListProxyModelTest::undoReplacePlayListCase()
 
     QVERIFY(mRowsAboutToBeInsertedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 3);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 4);
-    QCOMPARE(mRowsRemovedSpy->count(), 3);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 4);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 7);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 2);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 3);
@@ -2434,15 +2669,15 @@ void MediaPlayListProxyModelTest::undoReplacePlayListCase()
 
     mPlayListProxyModel->undoClearPlayList();
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 4);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 5);
-    QCOMPARE(mRowsRemovedSpy->count(), 4);
+    QCOMPARE(mRowsRemovedSpy->count(), 2);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 5);
-    QCOMPARE(mTracksCountChangedSpy->count(), 9);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 10);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mTracksCountChangedSpy->count(), 7);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 8);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 6);
     QCOMPARE(mNewEntryInListSpy->count(), 2);
     QCOMPARE(mCurrentTrackChangedSpy->count(), 5);
@@ -2838,14 +3073,14 @@ void MediaPlayListProxyModelTest::testRemoveSelection()
 
     QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(),1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -2903,14 +3138,14 @@ void MediaPlayListProxyModelTest::testRemoveSelection()
 
     mPlayListProxyModel->removeSelection({2, 4, 5});
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 4);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 3);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 4);
+    QCOMPARE(mRowsRemovedSpy->count(), 3);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 6);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -2962,16 +3197,16 @@ void MediaPlayListProxyModelTest::testReplaceAndPlayArtist()
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
-    QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
+    QCOMPARE(mDataChangedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
-    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
-    QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mRowsInsertedSpy->count(), 1);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 1);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -2993,27 +3228,27 @@ void MediaPlayListProxyModelTest::testReplaceAndPlayArtist()
     mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Artist}}, QStringLiteral("artist4"), {}}},
                                  ElisaUtils::PlayListEnqueueMode::ReplacePlayList, ElisaUtils::PlayListEnqueueTriggerPlay::TriggerPlay);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
-    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 3);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
-    QCOMPARE(mRowsInsertedSpy->count(), 3);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 5);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mRowsInsertedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 2);
 
-    QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
+    QCOMPARE(mDataChangedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 3);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
-    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 4);
-    QCOMPARE(mRowsRemovedSpy->count(), 3);
+    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
-    QCOMPARE(mRowsInsertedSpy->count(), 4);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 7);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mRowsInsertedSpy->count(), 2);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 2);
 
@@ -3148,14 +3383,14 @@ void MediaPlayListProxyModelTest::testTrackBeenRemoved()
 
     QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -3222,14 +3457,14 @@ void MediaPlayListProxyModelTest::testTrackBeenRemoved()
 
     mPlayList->trackRemoved(removedTrack[DataTypes::DatabaseIdRole].toULongLong());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mPersistentStateChangedSpy->count(), 3);
-    QCOMPARE(mDataChangedSpy->count(), 1);
+    QCOMPARE(mPersistentStateChangedSpy->count(), 2);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -84,8 +84,12 @@ private Q_SLOTS:
 
     void testRestoreSettings();
 
+    void testRestoreDuplicatedShuffledRows();
+
     void testSaveAndRestoreSettings();
 
+    void testRestoreCorruptedSettings();
+
     void testBringUpAndSkipPreviousAndContinueCase();
 
     void testBringUpAndRemoveMultipleNotBeginCase();
@@ -138,6 +142,12 @@ private Q_SLOTS:
 
     void remainingTracksTest();
 
+    void tracksDurationTest();
+
+    void benchmarkShuffledEnqueue_data();
+
+    void benchmarkShuffledEnqueue();
+
     void clearPlayListCase();
 
     void undoClearPlayListCase();
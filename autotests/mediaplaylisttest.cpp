@@ -20,6 +20,8 @@
 #include <QTemporaryFile>
 #include <QAbstractItemModelTester>
 
+#include <algorithm>
+
 using namespace Qt::Literals::StringLiterals;
 
 using TestTrackData = QMap<MediaPlayList::ColumnsRoles, QVariant>;
@@ -68,6 +70,7 @@ void MediaPlayListTest::init()
     mNewEntryInListSpy = new QSignalSpy(mPlayList, &MediaPlayList::newEntryInList);
     mNewTrackByNameInListSpy = new QSignalSpy(mPlayList, &MediaPlayList::newTrackByNameInList);
     mNewUrlInListSpy = new QSignalSpy(mPlayList, &MediaPlayList::newUrlInList);
+    mNewUrlsInListSpy = new QSignalSpy(mPlayList, &MediaPlayList::newUrlsInList);
 
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
@@ -80,12 +83,16 @@ void MediaPlayListTest::init()
     QCOMPARE(mNewEntryInListSpy->count(), 0);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewUrlInListSpy->count(), 0);
+    QCOMPARE(mNewUrlsInListSpy->count(), 0);
 
     mDatabaseContent->init(QStringLiteral("testDbDirectContent"));
 
     connect(mListener, &TracksListener::trackHasChanged,
             mPlayList, &MediaPlayList::trackChanged,
             Qt::QueuedConnection);
+    connect(mListener, &TracksListener::tracksHaveChanged,
+            mPlayList, &MediaPlayList::tracksChanged,
+            Qt::QueuedConnection);
     connect(mListener, &TracksListener::tracksListAdded,
             mPlayList, &MediaPlayList::tracksListAdded,
             Qt::QueuedConnection);
@@ -95,6 +102,12 @@ void MediaPlayListTest::init()
     connect(mPlayList, &MediaPlayList::newUrlInList,
             mListener, &TracksListener::newUrlInList,
             Qt::QueuedConnection);
+    connect(mPlayList, &MediaPlayList::newUrlsInList,
+            mListener, &TracksListener::newUrlsInList,
+            Qt::QueuedConnection);
+    connect(mPlayList, &MediaPlayList::newTracksInList,
+            mListener, &TracksListener::newTracksInList,
+            Qt::QueuedConnection);
     connect(mPlayList, &MediaPlayList::newTrackByNameInList,
             mListener, &TracksListener::trackByNameInList,
             Qt::QueuedConnection);
@@ -134,6 +147,7 @@ void MediaPlayListTest::cleanup()
     delete mNewTrackByNameInListSpy;
     delete mNewEntryInListSpy;
     delete mNewUrlInListSpy;
+    delete mNewUrlsInListSpy;
 }
 
 void MediaPlayListTest::simpleInitialCase()
@@ -170,15 +184,15 @@ void MediaPlayListTest::enqueueAlbumCase()
     mPlayList->enqueueOneEntry({{{DataTypes::DatabaseIdRole, mDatabaseContent->albumIdFromTitleAndArtist(QStringLiteral("album2"), QStringLiteral("artist1"), QStringLiteral("/"))}},
                         QStringLiteral("album2"), {}});
 
-    QVERIFY(mRowsAboutToBeRemovedSpy->wait());
+    QVERIFY(mDataChangedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -246,13 +260,13 @@ void MediaPlayListTest::enqueueArtistCase()
 
     QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -679,27 +693,27 @@ void MediaPlayListTest::removeFirstTrackOfAlbum()
     mPlayList->enqueueOneEntry({{{DataTypes::DatabaseIdRole, mDatabaseContent->albumIdFromTitleAndArtist(QStringLiteral("album2"), QStringLiteral("artist1"), QStringLiteral("/"))}},
                         QStringLiteral("album2"), {}});
 
-    QVERIFY(mRowsAboutToBeRemovedSpy->wait());
+    QVERIFY(mDataChangedSpy->wait());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
     mPlayList->removeRows(0, 1);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 2);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 2);
+    QCOMPARE(mRowsRemovedSpy->count(), 1);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 }
@@ -720,13 +734,13 @@ void MediaPlayListTest::testTrackBeenRemoved()
 
     QCOMPARE(mRowsAboutToBeInsertedSpy->wait(), true);
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 0);
+    QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -793,13 +807,13 @@ void MediaPlayListTest::testTrackBeenRemoved()
 
     mPlayList->trackRemoved(removedTrack[DataTypes::DatabaseIdRole].toULongLong());
 
-    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 1);
+    QCOMPARE(mRowsAboutToBeRemovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeMovedSpy->count(), 0);
     QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 2);
-    QCOMPARE(mRowsRemovedSpy->count(), 1);
+    QCOMPARE(mRowsRemovedSpy->count(), 0);
     QCOMPARE(mRowsMovedSpy->count(), 0);
     QCOMPARE(mRowsInsertedSpy->count(), 2);
-    QCOMPARE(mDataChangedSpy->count(), 1);
+    QCOMPARE(mDataChangedSpy->count(), 2);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 
@@ -1677,7 +1691,8 @@ void MediaPlayListTest::restoreLocalTrack()
     QCOMPARE(mRowsInsertedSpy->count(), 1);
     QCOMPARE(mDataChangedSpy->count(), 0);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
-    QCOMPARE(mNewEntryInListSpy->count(), 1);
+    QCOMPARE(mNewEntryInListSpy->count(), 0);
+    QCOMPARE(mNewUrlsInListSpy->count(), 1);
 
     QCOMPARE(mDataChangedSpy->wait(), true);
 
@@ -1689,7 +1704,8 @@ void MediaPlayListTest::restoreLocalTrack()
     QCOMPARE(mRowsInsertedSpy->count(), 1);
     QCOMPARE(mDataChangedSpy->count(), 1);
     QCOMPARE(mNewTrackByNameInListSpy->count(), 0);
-    QCOMPARE(mNewEntryInListSpy->count(), 1);
+    QCOMPARE(mNewEntryInListSpy->count(), 0);
+    QCOMPARE(mNewUrlsInListSpy->count(), 1);
 
     QCOMPARE(mPlayList->data(mPlayList->index(0, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("Title"));
     QCOMPARE(mPlayList->data(mPlayList->index(0, 0), MediaPlayList::AlbumRole).toString(), QStringLiteral("Test"));
@@ -2003,6 +2019,247 @@ void MediaPlayListTest::crashOnEnqueue()
     QCOMPARE(mNewEntryInListSpy->count(), 1);
 }
 
+void MediaPlayListTest::lazyEnqueueLargeList()
+{
+    const auto tracksCount = 10000;
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(tracksCount);
+    for (int i = 0; i < tracksCount; ++i) {
+        newEntries.push_back({{}, {}, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(i))});
+    }
+
+    mPlayList->enqueueMultipleEntries(newEntries);
+
+    QCOMPARE(mRowsAboutToBeInsertedSpy->count(), 1);
+    QCOMPARE(mRowsInsertedSpy->count(), 1);
+    QCOMPARE(mPlayList->rowCount(), tracksCount);
+    QCOMPARE(mNewUrlsInListSpy->count(), 0);
+
+    // a displayed entry is resolved in the first batch
+    QCOMPARE(mPlayList->data(mPlayList->index(5000, 0), MediaPlayList::ResourceRole).toUrl(), QUrl::fromLocalFile(QStringLiteral("/$5000.ogg")));
+    mPlayList->resolveEntriesFirst({5000});
+
+    QCOMPARE(mNewUrlsInListSpy->wait(), true);
+
+    QCOMPARE(mNewUrlsInListSpy->count(), 1);
+    const auto firstBatch = mNewUrlsInListSpy->at(0).at(0).value<QList<QUrl>>();
+    QVERIFY(firstBatch.contains(QUrl::fromLocalFile(QStringLiteral("/$5000.ogg"))));
+    QVERIFY(firstBatch.size() < tracksCount);
+
+    const auto resolvedEntriesCount = [this]() {
+        auto result = 0;
+        for (const auto &signalArguments : std::as_const(*mNewUrlsInListSpy)) {
+            result += signalArguments.at(0).value<QList<QUrl>>().size();
+        }
+        return result;
+    };
+    QTRY_COMPARE_WITH_TIMEOUT(resolvedEntriesCount(), tracksCount, 20000);
+    QCOMPARE(mNewUrlInListSpy->count(), 0);
+}
+
+void MediaPlayListTest::lazyEnqueueResolvesRequestedRowsFirst()
+{
+    const auto tracksCount = 10000;
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(tracksCount);
+    for (int i = 0; i < tracksCount; ++i) {
+        newEntries.push_back({{{DataTypes::DatabaseIdRole, i + 1},
+                               {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                               {DataTypes::TitleRole, QStringLiteral("track%1").arg(i)},
+                               {DataTypes::AlbumRole, QStringLiteral("album")},
+                               {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(i))}},
+                              QStringLiteral("track%1").arg(i), {}});
+    }
+
+    mPlayList->enqueueMultipleEntries(newEntries);
+
+    QCOMPARE(mPlayList->rowCount(), tracksCount);
+
+    // only the id and the url are kept until the entry is resolved
+    QCOMPARE(mPlayList->data(mPlayList->index(9000, 0), MediaPlayList::DatabaseIdRole).toULongLong(), 9001ULL);
+    QCOMPARE(mPlayList->data(mPlayList->index(9000, 0), MediaPlayList::ResourceRole).toUrl(), QUrl::fromLocalFile(QStringLiteral("/$9000.ogg")));
+    QCOMPARE(mPlayList->data(mPlayList->index(9000, 0), MediaPlayList::TitleRole).toString(), QStringLiteral("track9000"));
+    QVERIFY(!mPlayList->data(mPlayList->index(9000, 0), MediaPlayList::AlbumRole).isValid());
+
+    // reading the data of an entry does not make it resolved first
+    mPlayList->data(mPlayList->index(9500, 0), MediaPlayList::DurationRole);
+
+    mPlayList->resolveEntriesFirst({5000});
+
+    // the requested row follows its entry when rows before it are removed or moved
+    mPlayList->removeRows(0, 10);
+    QVERIFY(mPlayList->moveRows({}, 4990, 1, {}, mPlayList->rowCount()));
+    QCOMPARE(mPlayList->data(mPlayList->index(mPlayList->rowCount() - 1, 0), MediaPlayList::ResourceRole).toUrl(),
+             QUrl::fromLocalFile(QStringLiteral("/$5000.ogg")));
+
+    QCOMPARE(mNewUrlsInListSpy->wait(), true);
+
+    const auto firstBatch = mNewUrlsInListSpy->at(0).at(0).value<QList<QUrl>>();
+    QVERIFY(firstBatch.contains(QUrl::fromLocalFile(QStringLiteral("/$5000.ogg"))));
+    QVERIFY(!firstBatch.contains(QUrl::fromLocalFile(QStringLiteral("/$9500.ogg"))));
+}
+
+void MediaPlayListTest::entryNamesAreInterned()
+{
+    const auto firstEntry = MediaPlayListEntry{1, QStringLiteral("title1"), QString{QStringLiteral("artist") + QString::number(1)},
+                                               QString{QStringLiteral("album") + QString::number(1)}, {}, 1, 1};
+    const auto secondEntry = MediaPlayListEntry{2, QStringLiteral("title2"), QString{QStringLiteral("artist") + QString::number(1)},
+                                                QString{QStringLiteral("album") + QString::number(1)}, {}, 2, 1};
+
+    QCOMPARE(firstEntry.mArtist.toString(), QStringLiteral("artist1"));
+    QCOMPARE(secondEntry.mAlbum.toString(), QStringLiteral("album1"));
+    QCOMPARE(firstEntry.mArtist.toString().constData(), secondEntry.mArtist.toString().constData());
+    QCOMPARE(firstEntry.mAlbum.toString().constData(), secondEntry.mAlbum.toString().constData());
+    QVERIFY(!MediaPlayListEntry{3, QStringLiteral("title3"), {}, {}, {}, {}, {}}.mArtist.isValid());
+}
+
+void MediaPlayListTest::benchmarkEnqueueMultipleEntries_data()
+{
+    QTest::addColumn<int>("tracksCount");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("300k") << 300000;
+}
+
+void MediaPlayListTest::benchmarkEnqueueMultipleEntries()
+{
+    QFETCH(int, tracksCount);
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(tracksCount);
+    for (int i = 0; i < tracksCount; ++i) {
+        newEntries.push_back({{{DataTypes::DatabaseIdRole, i + 1},
+                               {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                               {DataTypes::TitleRole, QStringLiteral("track%1").arg(i)},
+                               {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(i))}},
+                              QStringLiteral("track%1").arg(i), {}});
+    }
+
+    QBENCHMARK_ONCE {
+        mPlayList->enqueueMultipleEntries(newEntries);
+    }
+
+    QCOMPARE(mPlayList->rowCount(), tracksCount);
+    QCOMPARE(mNewUrlsInListSpy->count(), 0);
+}
+
+void MediaPlayListTest::benchmarkTrackChanged_data()
+{
+    QTest::addColumn<int>("tracksCount");
+
+    QTest::newRow("20k") << 20000;
+    QTest::newRow("100k") << 100000;
+}
+
+void MediaPlayListTest::benchmarkTrackChanged()
+{
+    QFETCH(int, tracksCount);
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(tracksCount);
+    for (int i = 0; i < tracksCount; ++i) {
+        newEntries.push_back({{{DataTypes::DatabaseIdRole, i + 1},
+                               {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                               {DataTypes::TitleRole, QStringLiteral("track%1").arg(i)},
+                               {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(i))}},
+                              QStringLiteral("track%1").arg(i), {}});
+    }
+
+    mPlayList->enqueueMultipleEntries(newEntries);
+
+    QCOMPARE(mPlayList->rowCount(), tracksCount);
+
+    const auto changedTracksCount = 2000;
+    const auto dataChangedCount = mDataChangedSpy->count();
+
+    // the indexer notifies the play list of each track it has read
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < changedTracksCount; ++i) {
+            const auto row = i * (tracksCount / changedTracksCount);
+            mPlayList->trackChanged({{DataTypes::DatabaseIdRole, row + 1},
+                                     {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                     {DataTypes::TitleRole, QStringLiteral("track%1").arg(row)},
+                                     {DataTypes::DurationRole, QTime::fromMSecsSinceStartOfDay(row + 1)},
+                                     {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(row))}});
+        }
+    }
+
+    QCOMPARE(mDataChangedSpy->count(), dataChangedCount + changedTracksCount);
+
+    const auto lastChangedRow = (changedTracksCount - 1) * (tracksCount / changedTracksCount);
+    QCOMPARE(mPlayList->data(mPlayList->index(lastChangedRow, 0), MediaPlayList::IsValidRole).toBool(), true);
+    QCOMPARE(mPlayList->data(mPlayList->index(lastChangedRow, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay(), lastChangedRow + 1);
+}
+
+void MediaPlayListTest::benchmarkTracksListAdded_data()
+{
+    QTest::addColumn<int>("artistsCount");
+    QTest::addColumn<int>("tracksByArtistCount");
+    QTest::addColumn<int>("queuedTracksCount");
+
+    QTest::newRow("200 artists of 50 tracks before 20k tracks") << 200 << 50 << 20000;
+    QTest::newRow("20 artists of 1000 tracks before 100k tracks") << 20 << 1000 << 100000;
+}
+
+void MediaPlayListTest::benchmarkTracksListAdded()
+{
+    QFETCH(int, artistsCount);
+    QFETCH(int, tracksByArtistCount);
+    QFETCH(int, queuedTracksCount);
+
+    auto newEntries = DataTypes::EntryDataList{};
+    newEntries.reserve(artistsCount + queuedTracksCount);
+    for (int i = 0; i < artistsCount; ++i) {
+        newEntries.push_back({{{DataTypes::DatabaseIdRole, i + 1},
+                               {DataTypes::ElementTypeRole, ElisaUtils::Artist},
+                               {DataTypes::TitleRole, QStringLiteral("artist%1").arg(i)}},
+                              QStringLiteral("artist%1").arg(i), {}});
+    }
+    for (int i = 0; i < queuedTracksCount; ++i) {
+        newEntries.push_back({{{DataTypes::DatabaseIdRole, i + 1},
+                               {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                               {DataTypes::TitleRole, QStringLiteral("track%1").arg(i)},
+                               {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(i))}},
+                              QStringLiteral("track%1").arg(i), {}});
+    }
+
+    mPlayList->enqueueMultipleEntries(newEntries);
+
+    QCOMPARE(mPlayList->rowCount(), artistsCount + queuedTracksCount);
+
+    auto artistsTracks = QList<DataTypes::ListTrackDataType>{};
+    artistsTracks.reserve(artistsCount);
+    for (int i = 0; i < artistsCount; ++i) {
+        auto oneArtistTracks = DataTypes::ListTrackDataType{};
+        oneArtistTracks.reserve(tracksByArtistCount);
+        for (int j = 0; j < tracksByArtistCount; ++j) {
+            const auto trackId = queuedTracksCount + i * tracksByArtistCount + j + 1;
+            oneArtistTracks.push_back({{DataTypes::DatabaseIdRole, trackId},
+                                       {DataTypes::ElementTypeRole, ElisaUtils::Track},
+                                       {DataTypes::TitleRole, QStringLiteral("track%1").arg(trackId)},
+                                       {DataTypes::ArtistRole, QStringLiteral("artist%1").arg(i)},
+                                       {DataTypes::ResourceRole, QUrl::fromLocalFile(QStringLiteral("/$%1.ogg").arg(trackId))}});
+        }
+        artistsTracks.push_back(oneArtistTracks);
+    }
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < artistsCount; ++i) {
+            mPlayList->tracksListAdded(i + 1, QStringLiteral("artist%1").arg(i), ElisaUtils::Artist, artistsTracks[i]);
+        }
+    }
+
+    QCOMPARE(mPlayList->rowCount(), artistsCount * tracksByArtistCount + queuedTracksCount);
+    QCOMPARE(mPlayList->data(mPlayList->index(0, 0), MediaPlayList::ArtistRole).toString(), QStringLiteral("artist0"));
+    QCOMPARE(mPlayList->data(mPlayList->index(artistsCount * tracksByArtistCount - 1, 0), MediaPlayList::ArtistRole).toString(),
+             QStringLiteral("artist%1").arg(artistsCount - 1));
+    QCOMPARE(mPlayList->data(mPlayList->index(artistsCount * tracksByArtistCount, 0), MediaPlayList::TitleRole).toString(),
+             QStringLiteral("track0"));
+}
+
 void MediaPlayListTest::testHasHeaderMoveAnotherLikeQml()
 {
     auto firstTrackId = mDatabaseContent->trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album2"), 1, 1);
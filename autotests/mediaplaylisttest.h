@@ -86,6 +86,24 @@ private Q_SLOTS:
 
     void crashOnEnqueue();
 
+    void lazyEnqueueLargeList();
+
+    void lazyEnqueueResolvesRequestedRowsFirst();
+
+    void entryNamesAreInterned();
+
+    void benchmarkEnqueueMultipleEntries_data();
+
+    void benchmarkEnqueueMultipleEntries();
+
+    void benchmarkTrackChanged_data();
+
+    void benchmarkTrackChanged();
+
+    void benchmarkTracksListAdded_data();
+
+    void benchmarkTracksListAdded();
+
 private:
 
     MediaPlayList *mPlayList = nullptr;
@@ -104,6 +122,7 @@ private:
     QSignalSpy *mNewEntryInListSpy = nullptr;
     QSignalSpy *mNewTrackByNameInListSpy = nullptr;
     QSignalSpy *mNewUrlInListSpy = nullptr;
+    QSignalSpy *mNewUrlsInListSpy = nullptr;
 
 };
 
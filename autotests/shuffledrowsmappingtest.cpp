@@ -0,0 +1,314 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "shuffledrowsmapping.h"
+
+#include <QObject>
+#include <QList>
+#include <QRandomGenerator>
+
+#include <QTest>
+
+class ShuffledRowsMappingTests: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    /**
+     * reference implementation: the source row shown at each proxy row
+     * source rows that are not placed yet are tracked separately
+     */
+    struct ReferenceMapping
+    {
+        QList<int> mSourceRows;
+
+        QList<int> mUnplacedSourceRows;
+
+        int mSourceRowsCount = 0;
+
+        void assign(const QList<int> &sourceRows)
+        {
+            mSourceRows = sourceRows;
+            mUnplacedSourceRows.clear();
+            mSourceRowsCount = static_cast<int>(sourceRows.size());
+        }
+
+        void insertSourceRows(int first, int count)
+        {
+            for (auto &oneSourceRow : mSourceRows) {
+                if (oneSourceRow >= first) {
+                    oneSourceRow += count;
+                }
+            }
+            for (auto &oneSourceRow : mUnplacedSourceRows) {
+                if (oneSourceRow >= first) {
+                    oneSourceRow += count;
+                }
+            }
+            for (int i = 0; i < count; ++i) {
+                mUnplacedSourceRows.push_back(first + i);
+            }
+            mSourceRowsCount += count;
+        }
+
+        void placeSourceRow(int sourceRow, int proxyRow)
+        {
+            if (mUnplacedSourceRows.removeAll(sourceRow) == 0) {
+                return;
+            }
+            mSourceRows.insert(proxyRow, sourceRow);
+        }
+
+        void removeSourceRow(int sourceRow)
+        {
+            mSourceRows.removeAll(sourceRow);
+            mUnplacedSourceRows.removeAll(sourceRow);
+            for (auto &oneSourceRow : mSourceRows) {
+                if (oneSourceRow > sourceRow) {
+                    --oneSourceRow;
+                }
+            }
+            for (auto &oneSourceRow : mUnplacedSourceRows) {
+                if (oneSourceRow > sourceRow) {
+                    --oneSourceRow;
+                }
+            }
+            --mSourceRowsCount;
+        }
+
+        void moveProxyRow(int from, int to)
+        {
+            mSourceRows.move(from, to);
+        }
+    };
+
+    static void compareMappings(const ShuffledRowsMapping &mapping, const ReferenceMapping &reference)
+    {
+        QCOMPARE(mapping.size(), static_cast<int>(reference.mSourceRows.size()));
+        QCOMPARE(mapping.isEmpty(), reference.mSourceRows.isEmpty());
+        QCOMPARE(mapping.sourceRows(), reference.mSourceRows);
+
+        for (int proxyRow = 0; proxyRow < reference.mSourceRows.size(); ++proxyRow) {
+            QCOMPARE(mapping.sourceRow(proxyRow), reference.mSourceRows.at(proxyRow));
+        }
+        for (int sourceRow = 0; sourceRow < reference.mSourceRowsCount; ++sourceRow) {
+            QCOMPARE(mapping.proxyRow(sourceRow), static_cast<int>(reference.mSourceRows.indexOf(sourceRow)));
+        }
+
+        QCOMPARE(mapping.sourceRow(-1), -1);
+        QCOMPARE(mapping.sourceRow(static_cast<int>(reference.mSourceRows.size())), -1);
+        QCOMPARE(mapping.proxyRow(reference.mSourceRowsCount), -1);
+    }
+
+    static QList<int> shuffledRows(int rowsCount, QRandomGenerator &generator)
+    {
+        auto result = QList<int>{};
+        result.reserve(rowsCount);
+        for (int i = 0; i < rowsCount; ++i) {
+            result.insert(generator.bounded(i + 1), i);
+        }
+        return result;
+    }
+
+private Q_SLOTS:
+
+    void moveProxyRow_data()
+    {
+        QTest::addColumn<int>("from");
+        QTest::addColumn<int>("to");
+
+        QTest::newRow("first to last") << 0 << 9;
+        QTest::newRow("last to first") << 9 << 0;
+        QTest::newRow("first to second") << 0 << 1;
+        QTest::newRow("second to first") << 1 << 0;
+        QTest::newRow("last to before last") << 9 << 8;
+        QTest::newRow("before last to last") << 8 << 9;
+        QTest::newRow("first to first") << 0 << 0;
+        QTest::newRow("last to last") << 9 << 9;
+        QTest::newRow("middle forward") << 3 << 6;
+        QTest::newRow("middle backward") << 6 << 3;
+    }
+
+    void moveProxyRow()
+    {
+        QFETCH(int, from);
+        QFETCH(int, to);
+
+        const auto initialRows = QList<int>{7, 2, 9, 0, 4, 1, 8, 3, 6, 5};
+
+        ShuffledRowsMapping mapping;
+        mapping.assign(initialRows);
+
+        ReferenceMapping reference;
+        reference.assign(initialRows);
+
+        mapping.moveProxyRow(from, to);
+        reference.moveProxyRow(from, to);
+
+        compareMappings(mapping, reference);
+    }
+
+    void removeSourceRow_data()
+    {
+        QTest::addColumn<int>("sourceRow");
+
+        QTest::newRow("first source row") << 0;
+        QTest::newRow("last source row") << 9;
+        QTest::newRow("source row at first proxy row") << 7;
+        QTest::newRow("source row at last proxy row") << 5;
+        QTest::newRow("middle source row") << 4;
+    }
+
+    void removeSourceRow()
+    {
+        QFETCH(int, sourceRow);
+
+        const auto initialRows = QList<int>{7, 2, 9, 0, 4, 1, 8, 3, 6, 5};
+
+        ShuffledRowsMapping mapping;
+        mapping.assign(initialRows);
+
+        ReferenceMapping reference;
+        reference.assign(initialRows);
+
+        mapping.removeSourceRow(sourceRow);
+        reference.removeSourceRow(sourceRow);
+
+        compareMappings(mapping, reference);
+    }
+
+    void removeAllSourceRows()
+    {
+        const auto initialRows = QList<int>{3, 1, 0, 2};
+
+        ShuffledRowsMapping mapping;
+        mapping.assign(initialRows);
+
+        ReferenceMapping reference;
+        reference.assign(initialRows);
+
+        // alternatively remove the last and the first row
+        for (int i = 0; i < initialRows.size(); ++i) {
+            const auto sourceRow = (i % 2 == 0) ? reference.mSourceRowsCount - 1 : 0;
+            mapping.removeSourceRow(sourceRow);
+            reference.removeSourceRow(sourceRow);
+
+            compareMappings(mapping, reference);
+        }
+
+        QVERIFY(mapping.isEmpty());
+    }
+
+    void singleRow()
+    {
+        ShuffledRowsMapping mapping;
+        mapping.assign({0});
+
+        ReferenceMapping reference;
+        reference.assign({0});
+
+        mapping.moveProxyRow(0, 0);
+        reference.moveProxyRow(0, 0);
+
+        compareMappings(mapping, reference);
+
+        mapping.removeSourceRow(0);
+        reference.removeSourceRow(0);
+
+        compareMappings(mapping, reference);
+        QVERIFY(mapping.isEmpty());
+    }
+
+    void unplacedSourceRows()
+    {
+        ShuffledRowsMapping mapping;
+        mapping.assign({1, 0, 2});
+
+        ReferenceMapping reference;
+        reference.assign({1, 0, 2});
+
+        mapping.insertSourceRows(0, 2);
+        reference.insertSourceRows(0, 2);
+
+        compareMappings(mapping, reference);
+
+        // an unplaced row can be removed before it is placed
+        mapping.removeSourceRow(1);
+        reference.removeSourceRow(1);
+
+        compareMappings(mapping, reference);
+
+        mapping.placeSourceRow(0, 3);
+        reference.placeSourceRow(0, 3);
+
+        compareMappings(mapping, reference);
+
+        // placing a row twice does nothing
+        mapping.placeSourceRow(0, 0);
+        reference.placeSourceRow(0, 0);
+
+        compareMappings(mapping, reference);
+    }
+
+    void randomOperations()
+    {
+        auto generator = QRandomGenerator{42};
+
+        const auto initialRows = shuffledRows(50, generator);
+
+        ShuffledRowsMapping mapping;
+        mapping.assign(initialRows);
+
+        ReferenceMapping reference;
+        reference.assign(initialRows);
+
+        for (int i = 0; i < 2000; ++i) {
+            const auto placedRowsCount = static_cast<int>(reference.mSourceRows.size());
+
+            switch (generator.bounded(4)) {
+            case 0:
+            {
+                const auto first = generator.bounded(reference.mSourceRowsCount + 1);
+                const auto count = generator.bounded(1, 4);
+                mapping.insertSourceRows(first, count);
+                reference.insertSourceRows(first, count);
+                for (int j = 0; j < count; ++j) {
+                    const auto proxyRow = generator.bounded(static_cast<int>(reference.mSourceRows.size()) + 1);
+                    mapping.placeSourceRow(first + j, proxyRow);
+                    reference.placeSourceRow(first + j, proxyRow);
+                }
+                break;
+            }
+            case 1:
+            case 2:
+                if (placedRowsCount > 0) {
+                    const auto from = generator.bounded(placedRowsCount);
+                    const auto to = generator.bounded(placedRowsCount);
+                    mapping.moveProxyRow(from, to);
+                    reference.moveProxyRow(from, to);
+                }
+                break;
+            case 3:
+                if (reference.mSourceRowsCount > 0) {
+                    const auto sourceRow = generator.bounded(reference.mSourceRowsCount);
+                    mapping.removeSourceRow(sourceRow);
+                    reference.removeSourceRow(sourceRow);
+                }
+                break;
+            }
+
+            QCOMPARE(mapping.sourceRows(), reference.mSourceRows);
+        }
+
+        compareMappings(mapping, reference);
+    }
+};
+
+QTEST_GUILESS_MAIN(ShuffledRowsMappingTests)
+
+
+#include "shuffledrowsmappingtest.moc"
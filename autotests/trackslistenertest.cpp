@@ -20,6 +20,8 @@
 #include <QList>
 #include <QThread>
 #include <QStandardPaths>
+#include <QStringList>
+#include <QVariant>
 
 #include <QSignalSpy>
 #include <QTest>
@@ -470,6 +472,122 @@ private Q_SLOTS:
         QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::TrackNumberRole).toInt(), -1);
         QCOMPARE(myPlayList.data(myPlayList.index(0, 0), MediaPlayList::ColumnsRoles::DiscNumberRole).toInt(), 0);
     }
+
+    void testNonMatchingTrackByNameBeforeMatchingOne()
+    {
+        DatabaseInterface myDatabaseContent;
+        TracksListener myListener(&myDatabaseContent);
+
+        QSignalSpy trackHasChangedSpy(&myListener, &TracksListener::trackHasChanged);
+
+        myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+        connect(&myDatabaseContent, &DatabaseInterface::tracksAdded, &myListener, &TracksListener::tracksAdded);
+
+        // the first pending track never gets indexed, it must not hide the following ones
+        myListener.trackByNameInList(QStringLiteral("unknownTrack"), QStringLiteral("unknownArtist"), QStringLiteral("unknownAlbum"), 1, 1);
+        myListener.trackByNameInList(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album1"), 1, 1);
+        myListener.trackByNameInList(QStringLiteral("track2"), QStringLiteral("artist1"), QStringLiteral("album1"), 2, 2);
+
+        QCOMPARE(trackHasChangedSpy.count(), 0);
+
+        myDatabaseContent.insertTracksList(mNewTracks);
+
+        QCOMPARE(trackHasChangedSpy.count(), 2);
+
+        auto notifiedTitles = QStringList{};
+        for (const auto &signalArguments : std::as_const(trackHasChangedSpy)) {
+            notifiedTitles.push_back(signalArguments.at(0).value<TracksListener::TrackDataType>().title());
+        }
+        notifiedTitles.sort();
+        QCOMPARE(notifiedTitles, QStringList({QStringLiteral("track1"), QStringLiteral("track2")}));
+
+        // tracks matched by name are then followed by id
+        const auto trackId = myDatabaseContent.trackIdFromTitleAlbumTrackDiscNumber(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album1"), 1, 1);
+        auto modifiedTrack = myDatabaseContent.trackDataFromDatabaseId(trackId);
+        modifiedTrack[DataTypes::RatingRole] = 5;
+        myListener.trackModified(modifiedTrack);
+
+        QCOMPARE(trackHasChangedSpy.count(), 3);
+        QCOMPARE(trackHasChangedSpy.at(2).at(0).value<TracksListener::TrackDataType>().databaseId(), trackId);
+    }
+
+    void testTrackByNameWildcards_data()
+    {
+        QTest::addColumn<bool>("anyTitle");
+        QTest::addColumn<bool>("anyArtist");
+        QTest::addColumn<bool>("anyAlbum");
+
+        QTest::newRow("title, artist and album") << false << false << false;
+        QTest::newRow("any title") << true << false << false;
+        QTest::newRow("any artist") << false << true << false;
+        QTest::newRow("any album") << false << false << true;
+        QTest::newRow("any title and artist") << true << true << false;
+        QTest::newRow("any title and album") << true << false << true;
+        QTest::newRow("any artist and album") << false << true << true;
+        QTest::newRow("any title, artist and album") << true << true << true;
+    }
+
+    void testTrackByNameWildcards()
+    {
+        QFETCH(bool, anyTitle);
+        QFETCH(bool, anyArtist);
+        QFETCH(bool, anyAlbum);
+
+        DatabaseInterface myDatabaseContent;
+        TracksListener myListener(&myDatabaseContent);
+
+        QSignalSpy trackHasChangedSpy(&myListener, &TracksListener::trackHasChanged);
+
+        myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+        connect(&myDatabaseContent, &DatabaseInterface::tracksAdded, &myListener, &TracksListener::tracksAdded);
+
+        myListener.trackByNameInList(anyTitle ? QVariant{} : QVariant{QStringLiteral("track1")},
+                                     anyArtist ? QVariant{} : QVariant{QStringLiteral("artist1")},
+                                     anyAlbum ? QVariant{} : QVariant{QStringLiteral("album1")},
+                                     1, 1);
+
+        QCOMPARE(trackHasChangedSpy.count(), 0);
+
+        myDatabaseContent.insertTracksList(mNewTracks);
+
+        // a pending track is matched once, even when several indexed tracks fit
+        QCOMPARE(trackHasChangedSpy.count(), 1);
+
+        const auto notifiedTrack = trackHasChangedSpy.at(0).at(0).value<TracksListener::TrackDataType>();
+        QCOMPARE(notifiedTrack.trackNumber(), 1);
+        QCOMPARE(notifiedTrack.discNumber(), 1);
+        if (!anyTitle) {
+            QCOMPARE(notifiedTrack.title(), QStringLiteral("track1"));
+        }
+        if (!anyArtist) {
+            QCOMPARE(notifiedTrack.artist(), QStringLiteral("artist1"));
+        }
+        if (!anyAlbum) {
+            QCOMPARE(notifiedTrack.album(), QStringLiteral("album1"));
+        }
+    }
+
+    void testTrackByNameWithOtherNumbersIsNotMatched()
+    {
+        DatabaseInterface myDatabaseContent;
+        TracksListener myListener(&myDatabaseContent);
+
+        QSignalSpy trackHasChangedSpy(&myListener, &TracksListener::trackHasChanged);
+
+        myDatabaseContent.init(QStringLiteral("testDbDirectContent"));
+
+        connect(&myDatabaseContent, &DatabaseInterface::tracksAdded, &myListener, &TracksListener::tracksAdded);
+
+        // wildcards only apply to the names, never to the track and disc numbers
+        myListener.trackByNameInList({}, {}, {}, 99, 99);
+        myListener.trackByNameInList(QStringLiteral("track1"), QStringLiteral("artist1"), QStringLiteral("album1"), 1, 99);
+
+        myDatabaseContent.insertTracksList(mNewTracks);
+
+        QCOMPARE(trackHasChangedSpy.count(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(TracksListenerTests)
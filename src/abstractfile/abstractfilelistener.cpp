@@ -81,6 +81,11 @@ void AbstractFileListener::setAllRootPaths(const QStringList &allRootPaths)
     d->mFileListing->setAllRootPaths(allRootPaths);
 }
 
+void AbstractFileListener::setScanManifestFileName(const QString &fileName)
+{
+    d->mFileListing->setScanManifestFileName(fileName);
+}
+
 void AbstractFileListener::setFileListing(AbstractFileListing *fileIndexer)
 {
     d->mFileListing = fileIndexer;
@@ -62,6 +62,8 @@ public Q_SLOTS:
 
     void setAllRootPaths(const QStringList &allRootPaths);
 
+    void setScanManifestFileName(const QString &fileName);
+
 protected:
 
     void setFileListing(AbstractFileListing *fileIndexer);
@@ -10,17 +10,27 @@
 
 #include "abstractfile/indexercommon.h"
 
+#include "abstractfile/filesystemwatcherbackend.h"
 #include "filescanner.h"
+#include "coverfilecache.h"
+#include "coverstore.h"
 #include "elisa_settings.h"
 
 #include <QThread>
+#include <QThreadPool>
+#include <QThreadStorage>
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
-#include <QFileSystemWatcher>
+#include <QFuture>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QTimer>
 #include <QSet>
 #include <QAtomicInt>
 
+#include <QtConcurrentMap>
+
 
 #include <algorithm>
 #include <utility>
@@ -30,33 +40,136 @@ static QUrl getParentDirectory(const QUrl &filePath)
     return QUrl::fromLocalFile(QFileInfo{filePath.toLocalFile()}.absolutePath());
 }
 
-struct FileSystemPath {
-    QUrl path;
-    bool isFile;
+static bool hasChangedParentDirectory(const QString &path, const QSet<QString> &changedDirectories)
+{
+    auto currentPath = QFileInfo(path).absolutePath();
+
+    while (true) {
+        if (changedDirectories.contains(currentPath)) {
+            return true;
+        }
+
+        const auto parentPath = QFileInfo(currentPath).absolutePath();
+        if (parentPath == currentPath) {
+            return false;
+        }
+
+        currentPath = parentPath;
+    }
+}
+
+struct FileSystemEntry {
+    bool isFile = false;
     QDateTime lastModified;
 };
 
-inline bool operator==(const FileSystemPath &path1, const FileSystemPath &path2)
-{
-    return path1.path == path2.path && path1.isFile == path2.isFile;
-}
+/**
+ * Content of one discovered directory indexed by path
+ */
+using DirectoryContent = QHash<QUrl, FileSystemEntry>;
 
-inline size_t qHash(const FileSystemPath &fileSystemPath, size_t seed = 0)
+/**
+ * State of one directory at the time it was last listed
+ */
+struct DirectoryManifestEntry {
+    qint64 lastModified = 0;
+    qint64 metadataChangeTime = 0;
+    QList<QUrl> subDirectories;
+    quint32 tracksCount = 0;
+    quint64 tracksDigest = 0;
+    bool isTrusted = false;
+};
+
+static constexpr quint32 ScanManifestMagic = 0x454c534d;
+
+static constexpr quint32 ScanManifestVersion = 1;
+
+static std::pair<quint32, quint64> directoryTracksDigest(const DirectoryContent &directoryContent)
 {
-    return qHash(fileSystemPath.path, seed);
+    auto tracksCount = quint32{0};
+    auto tracksDigest = quint64{0};
+
+    for (const auto &[path, oneEntry] : directoryContent.asKeyValueRange()) {
+        if (oneEntry.isFile) {
+            ++tracksCount;
+            tracksDigest += qHash(path.toLocalFile(), 0);
+        }
+    }
+
+    return {tracksCount, tracksDigest};
 }
 
+struct PendingTrackScan {
+    QUrl file;
+    QUrl directory;
+    QFileInfo fileInfo;
+};
+
 class AbstractFileListingPrivate
 {
 public:
 
+    FileScanner &workerFileScanner()
+    {
+        if (!mWorkerFileScanners.hasLocalData()) {
+            auto *newFileScanner = new FileScanner;
+            newFileScanner->setCoverFileCache(&mCoverFileCache);
+            newFileScanner->setCoverStore(&mCoverStore);
+            mWorkerFileScanners.setLocalData(newFileScanner);
+        }
+
+        return *mWorkerFileScanners.localData();
+    }
+
     QStringList mAllRootPaths;
 
-    QFileSystemWatcher mFileSystemWatcher;
+    FileSystemWatcherBackend *mFileSystemWatcher = nullptr;
+
+    /**
+     * Restarted on each file system change: changes are processed once it has been quiet for its interval
+     */
+    QTimer *mChangesTimer = nullptr;
+
+    QSet<QString> mChangedDirectories;
+
+    QSet<QString> mChangedFiles;
+
+    /**
+     * Removed tracks collected while processing file system changes, notified all at once at the end
+     */
+    QList<QUrl> mDeferredRemovedTracks;
+
+    bool mDeferNotifications = false;
 
     QHash<QString, QUrl> mAllAlbumCover;
 
-    QHash<QUrl, QSet<FileSystemPath>> mDiscoveredDirectories;
+    QHash<QUrl, DirectoryContent> mDiscoveredDirectories;
+
+    QHash<QUrl, DirectoryManifestEntry> mScanManifest;
+
+    /**
+     * Files of each listed directory still waiting for extraction: the directory is only trusted by the manifest once none is left
+     */
+    QHash<QUrl, int> mUnfinishedDirectoryScans;
+
+    QString mScanManifestFileName;
+
+    bool mScanManifestLoaded = false;
+
+    /**
+     * Cover files found in each directory, shared by all scanners and invalidated on directory changes
+     */
+    CoverFileCache mCoverFileCache;
+
+    /**
+     * Thumbnails of the embedded covers, shared by all scanners
+     */
+    CoverStore mCoverStore;
+
+    /**
+     * Set when covers of removed tracks were forgotten: their thumbnails are removed once indexing is finished
+     */
+    bool mHasRemovedCovers = false;
 
     FileScanner mFileScanner;
 
@@ -74,14 +187,62 @@ public:
 
     bool mIsActive = false;
 
+    /**
+     * Files waiting to be handed to the extraction workers
+     */
+    QList<PendingTrackScan> mPendingScans;
+
+    /**
+     * Files currently being extracted by the workers, in the same order as the results of mRunningScansResult
+     */
+    QList<PendingTrackScan> mRunningScans;
+
+    QFuture<DataTypes::TrackDataType> mRunningScansResult;
+
+    qsizetype mScanBatchSize = 1;
+
+    /**
+     * KFileMetaData extractors are not thread-safe: each worker thread owns its own FileScanner
+     */
+    QThreadStorage<FileScanner*> mWorkerFileScanners;
+
+    /**
+     * Must be destroyed before mWorkerFileScanners so that worker threads release their scanner
+     */
+    QThreadPool mScanThreadPool;
+
 };
 
 AbstractFileListing::AbstractFileListing(QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>())
 {
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+    d->mFileScanner.setCoverFileCache(&d->mCoverFileCache);
+    d->mFileScanner.setCoverStore(&d->mCoverStore);
+
+    connect(this, &AbstractFileListing::removedTracksList, this, [this](const QList<QUrl> &removedTracks) {
+        if (d->mCoverStore.removeCovers(removedTracks) > 0) {
+            d->mHasRemovedCovers = true;
+        }
+    });
+    connect(this, &AbstractFileListing::indexingFinished, this, [this]() {
+        if (std::exchange(d->mHasRemovedCovers, false)) {
+            d->mCoverStore.removeUnusedThumbnails();
+        }
+    });
+
+    d->mFileSystemWatcher = FileSystemWatcherBackend::create(this);
+
+    connect(d->mFileSystemWatcher, &FileSystemWatcherBackend::directoryChanged,
             this, &AbstractFileListing::directoryChanged);
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+    connect(d->mFileSystemWatcher, &FileSystemWatcherBackend::fileChanged,
             this, &AbstractFileListing::fileChanged);
+
+    d->mChangesTimer = new QTimer(this);
+    d->mChangesTimer->setSingleShot(true);
+    connect(d->mChangesTimer, &QTimer::timeout,
+            this, &AbstractFileListing::processFileSystemChanges);
+
+    d->mScanThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+    d->mScanBatchSize = 16 * d->mScanThreadPool.maxThreadCount();
 }
 
 AbstractFileListing::~AbstractFileListing()
@@ -92,6 +253,8 @@ void AbstractFileListing::init()
     qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::init";
     d->mIsActive = true;
 
+    d->mChangesTimer->setInterval(Elisa::ElisaConfiguration::self()->fileSystemChangesQuietPeriod());
+
     const bool autoScan = Elisa::ElisaConfiguration::self()->scanAtStartup();
     if (autoScan) {
         Q_EMIT askRestoredTracks();
@@ -126,6 +289,12 @@ void AbstractFileListing::setAllRootPaths(const QStringList &allRootPaths)
     d->mAllRootPaths = allRootPaths;
 }
 
+void AbstractFileListing::setScanManifestFileName(const QString &fileName)
+{
+    d->mScanManifestFileName = fileName;
+    d->mScanManifestLoaded = false;
+}
+
 void AbstractFileListing::databaseFinishedInsertingTracksList()
 {
 }
@@ -159,6 +328,37 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         return;
     }
 
+    const QFileInfo directoryInfo(path.toLocalFile());
+    const auto directoryLastModified = directoryInfo.lastModified().toMSecsSinceEpoch();
+    const auto directoryMetadataChangeTime = directoryInfo.metadataChangeTime().toMSecsSinceEpoch();
+
+    if (const auto itManifest = d->mScanManifest.constFind(path); itManifest != d->mScanManifest.cend()) {
+        if (itManifest->isTrusted && directoryInfo.isDir() &&
+                itManifest->lastModified == directoryLastModified && itManifest->metadataChangeTime == directoryMetadataChangeTime) {
+            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << path << "directory not modified since last scan";
+
+            if (watchForFileSystemChanges & WatchChangedDirectories) {
+                watchPath(path.toLocalFile());
+            }
+
+            const auto subDirectories = itManifest->subDirectories;
+            for (const auto &oneSubDirectory : subDirectories) {
+                d->mDiscoveredDirectories[path].insert(oneSubDirectory, {false, QDateTime()});
+                scanDirectory(newFiles, oneSubDirectory, WatchChangedDirectories | WatchChangedFiles);
+
+                if (d->mStopRequest == 1) {
+                    break;
+                }
+            }
+
+            return;
+        }
+    }
+
+    // an interrupted listing must not leave a trusted entry behind
+    d->mScanManifest.remove(path);
+    d->mUnfinishedDirectoryScans.remove(path);
+
     QDir rootDirectory(path.toLocalFile());
     rootDirectory.refresh();
 
@@ -169,6 +369,7 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
     }
 
     auto currentFilesList = QSet<QUrl>();
+    auto currentSubDirectories = QList<QUrl>();
 
     rootDirectory.refresh();
     const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
@@ -178,27 +379,40 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
         if (oneEntry.isDir() || oneEntry.isFile()) {
             currentFilesList.insert(newFilePath);
         }
+
+        if (oneEntry.isDir()) {
+            currentSubDirectories.push_back(newFilePath);
+        }
     }
 
-    auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[path];
     auto allRemovedTracks = QList<QUrl>();
+    auto removedEntries = QList<std::pair<QUrl, bool>>();
 
-    for (const auto &removedFilePath : currentDirectoryListingFiles) {
-        if (currentFilesList.contains(removedFilePath.path)) {
+    auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[path];
+    for (auto itEntry = currentDirectoryListingFiles.begin(); itEntry != currentDirectoryListingFiles.end();) {
+        if (currentFilesList.contains(itEntry.key())) {
+            ++itEntry;
             continue;
         }
 
-        if (removedFilePath.isFile) {
-            allRemovedTracks.push_back(removedFilePath.path);
+        removedEntries.push_back({itEntry.key(), itEntry->isFile});
+        itEntry = currentDirectoryListingFiles.erase(itEntry);
+    }
+
+    for (const auto &[removedFilePath, isFile] : std::as_const(removedEntries)) {
+        if (isFile) {
+            allRemovedTracks.push_back(removedFilePath);
         } else {
-            removeFile(removedFilePath.path, allRemovedTracks);
+            removeFile(removedFilePath, allRemovedTracks);
         }
-
-        currentDirectoryListingFiles.remove(removedFilePath);
     }
 
     if (!allRemovedTracks.isEmpty()) {
-        Q_EMIT removedTracksList(allRemovedTracks);
+        if (d->mDeferNotifications) {
+            d->mDeferredRemovedTracks.append(allRemovedTracks);
+        } else {
+            Q_EMIT removedTracksList(allRemovedTracks);
+        }
     }
 
     if (!d->mHandleNewFiles) {
@@ -227,27 +441,113 @@ void AbstractFileListing::scanDirectory(DataTypes::ListTrackDataType &newFiles,
             continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry, WatchChangedDirectories | WatchChangedFiles);
+        d->mPendingScans.push_back({newFilePath, path, oneEntry});
+        ++d->mUnfinishedDirectoryScans[path];
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addFileInDirectory(newTrack.resourceURI(), path, WatchChangedDirectories | WatchChangedFiles);
-            newFiles.push_back(newTrack);
-
-            ++d->mImportedTracksCount;
-
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
-                d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
-            }
-        } else {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+        if (d->mPendingScans.size() >= d->mScanBatchSize) {
+            dispatchPendingScans(newFiles);
         }
 
         if (d->mStopRequest == 1) {
             break;
         }
     }
+
+    if (d->mStopRequest == 0 && rootDirectory.exists()) {
+        auto &manifestEntry = d->mScanManifest[path];
+        manifestEntry.lastModified = directoryLastModified;
+        manifestEntry.metadataChangeTime = directoryMetadataChangeTime;
+        manifestEntry.subDirectories = std::move(currentSubDirectories);
+        manifestEntry.isTrusted = !d->mUnfinishedDirectoryScans.contains(path);
+    }
+}
+
+void AbstractFileListing::dispatchPendingScans(DataTypes::ListTrackDataType &newFiles)
+{
+    collectRunningScans(newFiles);
+
+    if (d->mPendingScans.isEmpty() || d->mStopRequest == 1) {
+        d->mPendingScans.clear();
+        return;
+    }
+
+    d->mRunningScans = std::exchange(d->mPendingScans, {});
+
+    auto *privateData = d.get();
+    d->mRunningScansResult = QtConcurrent::mapped(&d->mScanThreadPool, d->mRunningScans,
+                                                  [privateData](const PendingTrackScan &oneScan) {
+        if (privateData->mStopRequest == 1) {
+            return DataTypes::TrackDataType{};
+        }
+
+        auto &workerScanner = privateData->workerFileScanner();
+
+        if (!workerScanner.shouldScanFile(oneScan.file.toLocalFile())) {
+            qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::dispatchPendingScans" << oneScan.file << "invalid mime type";
+            return DataTypes::TrackDataType{};
+        }
+
+        return workerScanner.scanOneFile(oneScan.file, oneScan.fileInfo);
+    });
+}
+
+void AbstractFileListing::collectRunningScans(DataTypes::ListTrackDataType &newFiles)
+{
+    if (d->mRunningScans.isEmpty()) {
+        return;
+    }
+
+    d->mRunningScansResult.waitForFinished();
+
+    const auto runningScans = std::exchange(d->mRunningScans, {});
+    const auto scannedTracks = d->mRunningScansResult.results();
+    d->mRunningScansResult = {};
+
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
+    for (qsizetype i = 0; i < runningScans.size() && i < scannedTracks.size(); ++i) {
+        const auto &oneScan = runningScans[i];
+        const auto &newTrack = scannedTracks[i];
+
+        directoryFileScanned(oneScan.directory);
+
+        if (!newTrack.isValid()) {
+            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::collectRunningScans" << oneScan.file << "is not a valid track";
+            continue;
+        }
+
+        if (oneScan.fileInfo.exists()) {
+            watchFile(oneScan.file.toLocalFile());
+        }
+
+        addFileInDirectory(newTrack.resourceURI(), oneScan.directory, WatchChangedDirectories | WatchChangedFiles);
+        newFiles.push_back(newTrack);
+
+        ++d->mImportedTracksCount;
+
+        if (!d->mDeferNotifications && newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
+            d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
+            emitNewFiles(newFiles);
+            newFiles.clear();
+        }
+    }
+}
+
+void AbstractFileListing::directoryFileScanned(const QUrl &directory)
+{
+    const auto itUnfinishedScans = d->mUnfinishedDirectoryScans.find(directory);
+    if (itUnfinishedScans == d->mUnfinishedDirectoryScans.end() || --(*itUnfinishedScans) > 0) {
+        return;
+    }
+
+    d->mUnfinishedDirectoryScans.erase(itUnfinishedScans);
+
+    // the manifest entry only exists once the directory has been completely listed
+    if (const auto itManifest = d->mScanManifest.find(directory); itManifest != d->mScanManifest.end()) {
+        itManifest->isTrusted = true;
+    }
 }
 
 void AbstractFileListing::directoryChanged(const QString &path)
@@ -256,23 +556,79 @@ void AbstractFileListing::directoryChanged(const QString &path)
         return;
     }
 
-    Q_EMIT indexingStarted();
-
-    scanDirectoryTree(path);
+    d->mCoverFileCache.invalidate(path);
 
-    Q_EMIT indexingFinished();
+    d->mChangedDirectories.insert(path);
+    d->mChangesTimer->start();
 }
 
 void AbstractFileListing::fileChanged(const QString &modifiedFileName)
 {
-    QFileInfo modifiedFileInfo(modifiedFileName);
-    auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
+    d->mChangedFiles.insert(modifiedFileName);
+    d->mChangesTimer->start();
+}
 
-    auto modifiedTrack = scanOneFile(modifiedFile, modifiedFileInfo, WatchChangedDirectories | WatchChangedFiles);
+void AbstractFileListing::processFileSystemChanges()
+{
+    const auto changedDirectories = std::exchange(d->mChangedDirectories, {});
+    const auto changedFiles = std::exchange(d->mChangedFiles, {});
 
-    if (modifiedTrack.isValid()) {
-        Q_EMIT modifyTracksList({modifiedTrack});
+    if (d->mStopRequest == 1) {
+        return;
     }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::processFileSystemChanges"
+                                  << changedDirectories.size() << "directories" << changedFiles.size() << "files";
+
+    Q_EMIT indexingStarted();
+
+    d->mDeferNotifications = true;
+
+    auto newFiles = DataTypes::ListTrackDataType();
+
+    for (const auto &oneDirectory : changedDirectories) {
+        // the scan of a changed parent directory also scans this one
+        if (hasChangedParentDirectory(oneDirectory, changedDirectories)) {
+            continue;
+        }
+
+        const auto directoryUrl = QUrl::fromLocalFile(oneDirectory);
+        if (!d->mDiscoveredDirectories.contains(directoryUrl)) {
+            continue;
+        }
+
+        scanDirectory(newFiles, directoryUrl, WatchChangedDirectories | WatchChangedFiles);
+    }
+
+    for (const auto &oneFile : changedFiles) {
+        // the scan of a changed directory already scans its modified files
+        if (hasChangedParentDirectory(oneFile, changedDirectories)) {
+            continue;
+        }
+
+        const QFileInfo oneFileInfo(oneFile);
+        d->mPendingScans.push_back({QUrl::fromLocalFile(oneFile), QUrl::fromLocalFile(oneFileInfo.absolutePath()), oneFileInfo});
+
+        if (d->mPendingScans.size() >= d->mScanBatchSize) {
+            dispatchPendingScans(newFiles);
+        }
+    }
+
+    dispatchPendingScans(newFiles);
+    collectRunningScans(newFiles);
+
+    d->mDeferNotifications = false;
+
+    const auto removedTracks = std::exchange(d->mDeferredRemovedTracks, {});
+    if (!removedTracks.isEmpty()) {
+        Q_EMIT removedTracksList(removedTracks);
+    }
+
+    if (!newFiles.isEmpty() && d->mStopRequest == 0) {
+        emitNewFiles(newFiles);
+    }
+
+    Q_EMIT indexingFinished();
 }
 
 void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
@@ -291,7 +647,7 @@ void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
 
         if (indexThisPath) {
             const auto parentPath = getParentDirectory(pathToBeIndexed);
-            d->mDiscoveredDirectories[parentPath].insert({pathToBeIndexed, true, lastModified});
+            d->mDiscoveredDirectories[parentPath].insert(pathToBeIndexed, {true, lastModified});
         } else {
             removedPaths.push_back(pathToBeIndexed);
         }
@@ -300,6 +656,16 @@ void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
     if (!removedPaths.isEmpty()) {
         Q_EMIT removedTracksList(removedPaths);
     }
+
+    if (!d->mScanManifestLoaded) {
+        loadScanManifest();
+    }
+
+    for (auto itManifest = d->mScanManifest.begin(); itManifest != d->mScanManifest.end(); ++itManifest) {
+        const auto [tracksCount, tracksDigest] = directoryTracksDigest(d->mDiscoveredDirectories.value(itManifest.key()));
+        itManifest->isTrusted = !d->mUnfinishedDirectoryScans.contains(itManifest.key()) &&
+                itManifest->tracksCount == tracksCount && itManifest->tracksDigest == tracksDigest;
+    }
 }
 
 void AbstractFileListing::triggerStop()
@@ -319,6 +685,9 @@ void AbstractFileListing::resetAndRefreshContent()
 
 void AbstractFileListing::refreshContent()
 {
+    // a directory changed while it could not be watched still has its old cover cached
+    d->mCoverFileCache.clear();
+
     triggerRefreshOfContent();
 }
 
@@ -339,7 +708,7 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
     if (newTrack.isValid() && scanFileInfo.exists()) {
         if (watchForFileSystemChanges & WatchChangedFiles) {
-            watchPath(scanFile.toLocalFile());
+            watchFile(scanFile.toLocalFile());
         }
     }
 
@@ -348,13 +717,27 @@ DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile,
 
 void AbstractFileListing::watchPath(const QString &pathName)
 {
-    if (!d->mFileSystemWatcher.addPath(pathName)) {
+    if (!d->mFileSystemWatcher->addDirectory(pathName)) {
         qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
 
-        if (!d->mErrorWatchingFileSystemChanges) {
-            d->mErrorWatchingFileSystemChanges = true;
-            Q_EMIT errorWatchingFileSystemChanges();
-        }
+        reportErrorWatchingFileSystemChanges();
+    }
+}
+
+void AbstractFileListing::watchFile(const QString &fileName)
+{
+    if (!d->mFileSystemWatcher->addFile(fileName)) {
+        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchFile" << "fail for" << fileName;
+
+        reportErrorWatchingFileSystemChanges();
+    }
+}
+
+void AbstractFileListing::reportErrorWatchingFileSystemChanges()
+{
+    if (!d->mErrorWatchingFileSystemChanges) {
+        d->mErrorWatchingFileSystemChanges = true;
+        Q_EMIT errorWatchingFileSystemChanges();
     }
 }
 
@@ -377,13 +760,13 @@ void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &di
 
             auto &parentCurrentDirectoryListingFiles = d->mDiscoveredDirectories[parentDirectory];
 
-            parentCurrentDirectoryListingFiles.insert({directoryName, false, QDateTime()});
+            parentCurrentDirectoryListingFiles.insert(directoryName, {false, QDateTime()});
         }
     }
     auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[directoryName];
 
     QFileInfo newFileInfo(newFile.toLocalFile());
-    currentDirectoryListingFiles.insert({newFile, newFileInfo.isFile(), newFileInfo.metadataChangeTime()});
+    currentDirectoryListingFiles.insert(newFile, {newFileInfo.isFile(), newFileInfo.metadataChangeTime()});
 }
 
 void AbstractFileListing::scanDirectoryTree(const QString &path)
@@ -394,6 +777,9 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
 
     scanDirectory(newFiles, QUrl::fromLocalFile(path), WatchChangedDirectories | WatchChangedFiles);
 
+    dispatchPendingScans(newFiles);
+    collectRunningScans(newFiles);
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
@@ -411,23 +797,21 @@ void AbstractFileListing::emitNewFiles(const DataTypes::ListTrackDataType &track
 
 void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
 {
-    const auto itRemovedDirectory = d->mDiscoveredDirectories.constFind(removedDirectory);
-
-    if (itRemovedDirectory == d->mDiscoveredDirectories.cend()) {
+    if (!d->mDiscoveredDirectories.contains(removedDirectory)) {
         return;
     }
 
-    const auto &currentRemovedDirectory = *itRemovedDirectory;
-    for (const auto &itFile : currentRemovedDirectory) {
-        if (itFile.path.isValid() && !itFile.path.isEmpty()) {
-            removeFile(itFile.path, allRemovedFiles);
-            if (itFile.isFile) {
-                allRemovedFiles.push_back(itFile.path);
+    const auto currentRemovedDirectory = d->mDiscoveredDirectories.take(removedDirectory);
+    d->mScanManifest.remove(removedDirectory);
+
+    for (const auto &[filePath, oneFile] : currentRemovedDirectory.asKeyValueRange()) {
+        if (filePath.isValid() && !filePath.isEmpty()) {
+            removeFile(filePath, allRemovedFiles);
+            if (oneFile.isFile) {
+                allRemovedFiles.push_back(filePath);
             }
         }
     }
-
-    d->mDiscoveredDirectories.erase(itRemovedDirectory);
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
@@ -457,6 +841,90 @@ bool AbstractFileListing::isActive() const
     return d->mIsActive;
 }
 
+void AbstractFileListing::loadScanManifest()
+{
+    d->mScanManifestLoaded = true;
+    d->mScanManifest.clear();
+
+    if (d->mScanManifestFileName.isEmpty()) {
+        return;
+    }
+
+    QFile manifestFile(d->mScanManifestFileName);
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream manifestStream(&manifestFile);
+    manifestStream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 entriesCount = 0;
+    manifestStream >> magic >> version >> entriesCount;
+
+    if (magic != ScanManifestMagic || version != ScanManifestVersion || entriesCount < 0) {
+        qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::loadScanManifest" << "ignoring incompatible manifest" << d->mScanManifestFileName;
+        return;
+    }
+
+    d->mScanManifest.reserve(entriesCount);
+    for (qint64 i = 0; i < entriesCount && manifestStream.status() == QDataStream::Ok; ++i) {
+        QUrl directory;
+        DirectoryManifestEntry oneEntry;
+
+        manifestStream >> directory >> oneEntry.lastModified >> oneEntry.metadataChangeTime
+                       >> oneEntry.subDirectories >> oneEntry.tracksCount >> oneEntry.tracksDigest;
+
+        d->mScanManifest.insert(directory, std::move(oneEntry));
+    }
+
+    if (manifestStream.status() != QDataStream::Ok) {
+        qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::loadScanManifest" << "ignoring corrupted manifest" << d->mScanManifestFileName;
+        d->mScanManifest.clear();
+        return;
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::loadScanManifest" << d->mScanManifest.size() << "directories";
+}
+
+void AbstractFileListing::saveScanManifest()
+{
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
+    for (auto itManifest = d->mScanManifest.begin(); itManifest != d->mScanManifest.end(); ++itManifest) {
+        const auto [tracksCount, tracksDigest] = directoryTracksDigest(d->mDiscoveredDirectories.value(itManifest.key()));
+        itManifest->tracksCount = tracksCount;
+        itManifest->tracksDigest = tracksDigest;
+    }
+
+    if (d->mScanManifestFileName.isEmpty()) {
+        return;
+    }
+
+    QSaveFile manifestFile(d->mScanManifestFileName);
+    if (!manifestFile.open(QIODevice::WriteOnly)) {
+        qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::saveScanManifest" << "cannot write" << d->mScanManifestFileName;
+        return;
+    }
+
+    QDataStream manifestStream(&manifestFile);
+    manifestStream.setVersion(QDataStream::Qt_6_0);
+
+    manifestStream << ScanManifestMagic << ScanManifestVersion << static_cast<qint64>(d->mScanManifest.size());
+
+    for (const auto &[directory, oneEntry] : d->mScanManifest.asKeyValueRange()) {
+        manifestStream << directory << oneEntry.lastModified << oneEntry.metadataChangeTime
+                       << oneEntry.subDirectories << oneEntry.tracksCount << oneEntry.tracksDigest;
+    }
+
+    if (!manifestFile.commit()) {
+        qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::saveScanManifest" << "cannot write" << d->mScanManifestFileName;
+    }
+}
+
 bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QUrl &parentPath, const QDateTime &lastModified) const
 {
     const auto parentDir = d->mDiscoveredDirectories.constFind(parentPath);
@@ -464,8 +932,7 @@ bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QUrl
         return true;
     }
 
-    const auto itPath = std::find_if(parentDir->cbegin(), parentDir->cend(),
-                                     [&](const auto &onePath) { return onePath.path == path; });
+    const auto itPath = parentDir->constFind(path);
     if (itPath == parentDir->cend()) {
         return true;
     }
@@ -88,16 +88,35 @@ public Q_SLOTS:
 
     void setAllRootPaths(const QStringList &allRootPaths);
 
+    /**
+     * Set the file used to persist the state of the scanned directories between two runs
+     *
+     * A directory whose modification and metadata change times match the ones recorded there, and whose
+     * indexed tracks are the ones recorded there, is not listed again when refreshing the content.
+     */
+    void setScanManifestFileName(const QString &fileName);
+
     void databaseFinishedInsertingTracksList();
 
     void databaseFinishedRemovingTracksList();
 
 protected Q_SLOTS:
 
+    /**
+     * Record a changed directory: it is rescanned once no change happened during the quiet period
+     */
     void directoryChanged(const QString &path);
 
+    /**
+     * Record a modified file: it is rescanned once no change happened during the quiet period
+     */
     void fileChanged(const QString &modifiedFileName);
 
+    /**
+     * Rescan all changed directories and files in one pass and notify the results at once
+     */
+    void processFileSystemChanges();
+
 protected:
 
     virtual void executeInit(const QHash<QUrl, QDateTime> &allFiles);
@@ -108,10 +127,35 @@ protected:
 
     void scanDirectory(DataTypes::ListTrackDataType &newFiles, const QUrl &path, FileSystemWatchingModes watchForFileSystemChanges);
 
+    /**
+     * Wait for the previous batch of files to be extracted and hand the pending files to the extraction workers
+     */
+    void dispatchPendingScans(DataTypes::ListTrackDataType &newFiles);
+
+    /**
+     * Wait for the running extraction batch and record its valid tracks into newFiles
+     */
+    void collectRunningScans(DataTypes::ListTrackDataType &newFiles);
+
+    /**
+     * Record that one file of directory has been extracted and trust the directory once all its files are
+     */
+    void directoryFileScanned(const QUrl &directory);
+
     virtual DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges);
 
+    /**
+     * Watch a directory for added, removed or renamed entries
+     */
     void watchPath(const QString &pathName);
 
+    /**
+     * Watch a track file for modifications
+     */
+    void watchFile(const QString &fileName);
+
+    void reportErrorWatchingFileSystemChanges();
+
     void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, FileSystemWatchingModes watchForFileSystemChanges);
 
     void scanDirectoryTree(const QString &path);
@@ -132,6 +176,13 @@ protected:
 
     [[nodiscard]] bool isActive() const;
 
+    void loadScanManifest();
+
+    /**
+     * Record the tracks known for each listed directory and persist the manifest if a file was set
+     */
+    void saveScanManifest();
+
     [[nodiscard]] bool fileModifiedSinceLastScan(const QUrl &path, const QUrl &parentPath, const QDateTime &lastModified) const;
 
 private:
@@ -0,0 +1,302 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filesystemwatcherbackend.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#if defined Q_OS_LINUX && !defined Q_OS_ANDROID
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <memory>
+
+namespace
+{
+
+/**
+ * Portable backend: one QFileSystemWatcher watch per directory and per file
+ */
+class QtFileSystemWatcherBackend : public FileSystemWatcherBackend
+{
+public:
+
+    explicit QtFileSystemWatcherBackend(QObject *parent)
+        : FileSystemWatcherBackend(parent), mFileSystemWatcher(this)
+    {
+        connect(&mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
+                this, [this](const QString &path) { forgetRemovedPath(path); Q_EMIT directoryChanged(path); });
+        connect(&mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
+                this, [this](const QString &path) { forgetRemovedPath(path); Q_EMIT fileChanged(path); });
+    }
+
+    bool addDirectory(const QString &directoryName) override
+    {
+        return addPath(directoryName);
+    }
+
+    bool addFile(const QString &fileName) override
+    {
+        return addPath(fileName);
+    }
+
+    [[nodiscard]] int watchesCount() const override
+    {
+        return static_cast<int>(mWatchedPaths.size());
+    }
+
+private:
+
+    bool addPath(const QString &path)
+    {
+        if (mWatchedPaths.contains(path)) {
+            return true;
+        }
+
+        if (!hasFreeWatch() || !mFileSystemWatcher.addPath(path)) {
+            return false;
+        }
+
+        mWatchedPaths.insert(path);
+
+        return true;
+    }
+
+    /**
+     * QFileSystemWatcher stops watching a removed path on its own
+     */
+    void forgetRemovedPath(const QString &path)
+    {
+        if (!QFileInfo::exists(path)) {
+            mWatchedPaths.remove(path);
+        }
+    }
+
+    QFileSystemWatcher mFileSystemWatcher;
+
+    /**
+     * Paths given to mFileSystemWatcher: asking it for its lists copies them on each call
+     */
+    QSet<QString> mWatchedPaths;
+
+};
+
+#if defined Q_OS_LINUX && !defined Q_OS_ANDROID
+
+/**
+ * Linux backend: one inotify watch per directory
+ *
+ * Changes of the watched files are reported from the events of their directory, so watching a file
+ * does not consume an inotify watch. All events read at once are coalesced before being reported.
+ */
+class InotifyWatcherBackend : public FileSystemWatcherBackend
+{
+public:
+
+    explicit InotifyWatcherBackend(QObject *parent)
+        : FileSystemWatcherBackend(parent), mInotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    {
+        if (mInotifyFd < 0) {
+            return;
+        }
+
+        mNotifier = std::make_unique<QSocketNotifier>(mInotifyFd, QSocketNotifier::Read, this);
+        connect(mNotifier.get(), &QSocketNotifier::activated, this, [this]() { readEvents(); });
+    }
+
+    ~InotifyWatcherBackend() override
+    {
+        mNotifier.reset();
+
+        if (mInotifyFd >= 0) {
+            ::close(mInotifyFd);
+        }
+    }
+
+    [[nodiscard]] bool isValid() const
+    {
+        return mInotifyFd >= 0;
+    }
+
+    bool addDirectory(const QString &directoryName) override
+    {
+        if (mWatchByDirectory.contains(directoryName)) {
+            return true;
+        }
+
+        if (!hasFreeWatch()) {
+            return false;
+        }
+
+        const auto watchDescriptor = inotify_add_watch(mInotifyFd, QFile::encodeName(directoryName).constData(), WatchedEvents);
+        if (watchDescriptor < 0) {
+            return false;
+        }
+
+        mWatchByDirectory.insert(directoryName, watchDescriptor);
+        mDirectoryByWatch.insert(watchDescriptor, directoryName);
+
+        return true;
+    }
+
+    bool addFile(const QString &fileName) override
+    {
+        const QFileInfo fileInfo(fileName);
+        if (!addDirectory(fileInfo.absolutePath())) {
+            return false;
+        }
+
+        mWatchedFiles.insert(fileInfo.absoluteFilePath());
+
+        return true;
+    }
+
+    [[nodiscard]] int watchesCount() const override
+    {
+        return static_cast<int>(mWatchByDirectory.size());
+    }
+
+private:
+
+    static constexpr uint32_t WatchedEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    void forgetWatch(int watchDescriptor)
+    {
+        const auto directoryName = mDirectoryByWatch.take(watchDescriptor);
+        if (mWatchByDirectory.value(directoryName, -1) == watchDescriptor) {
+            mWatchByDirectory.remove(directoryName);
+        }
+    }
+
+    void readEvents()
+    {
+        auto changedDirectories = QSet<QString>();
+        auto changedFiles = QSet<QString>();
+
+        alignas(inotify_event) char buffer[16 * 1024];
+
+        while (true) {
+            const auto length = ::read(mInotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+
+            for (auto position = 0; position < length;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(buffer + position);
+                position += static_cast<int>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    qCInfo(orgKdeElisaIndexer()) << "InotifyWatcherBackend::readEvents" << "event queue overflow";
+                    for (const auto &oneDirectory : std::as_const(mDirectoryByWatch)) {
+                        changedDirectories.insert(oneDirectory);
+                    }
+                    continue;
+                }
+
+                const auto itDirectory = mDirectoryByWatch.constFind(event->wd);
+                if (itDirectory == mDirectoryByWatch.cend()) {
+                    continue;
+                }
+
+                const auto directoryName = *itDirectory;
+
+                if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
+                    changedDirectories.insert(directoryName);
+                    if (!(event->mask & IN_IGNORED)) {
+                        inotify_rm_watch(mInotifyFd, event->wd);
+                    }
+                    forgetWatch(event->wd);
+                    continue;
+                }
+
+                if (event->len == 0) {
+                    continue;
+                }
+
+                const auto entryName = QFile::decodeName(event->name);
+                const auto entryPath = directoryName.endsWith(QLatin1Char('/')) ?
+                            directoryName + entryName :
+                            directoryName + QLatin1Char('/') + entryName;
+
+                if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) {
+                    changedDirectories.insert(directoryName);
+
+                    if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                        mWatchedFiles.remove(entryPath);
+                    }
+                } else if ((event->mask & (IN_CLOSE_WRITE | IN_ATTRIB)) && mWatchedFiles.contains(entryPath)) {
+                    changedFiles.insert(entryPath);
+                }
+            }
+        }
+
+        for (const auto &oneDirectory : std::as_const(changedDirectories)) {
+            Q_EMIT directoryChanged(oneDirectory);
+        }
+
+        for (const auto &oneFile : std::as_const(changedFiles)) {
+            Q_EMIT fileChanged(oneFile);
+        }
+    }
+
+    int mInotifyFd = -1;
+
+    std::unique_ptr<QSocketNotifier> mNotifier;
+
+    QHash<QString, int> mWatchByDirectory;
+
+    QHash<int, QString> mDirectoryByWatch;
+
+    QSet<QString> mWatchedFiles;
+
+};
+
+#endif
+
+}
+
+FileSystemWatcherBackend::FileSystemWatcherBackend(QObject *parent) : QObject(parent)
+{
+}
+
+FileSystemWatcherBackend::~FileSystemWatcherBackend()
+= default;
+
+void FileSystemWatcherBackend::setMaximumWatches(int maximumWatches)
+{
+    mMaximumWatches = maximumWatches;
+}
+
+bool FileSystemWatcherBackend::hasFreeWatch() const
+{
+    return watchesCount() < mMaximumWatches;
+}
+
+FileSystemWatcherBackend *FileSystemWatcherBackend::create(QObject *parent)
+{
+#if defined Q_OS_LINUX && !defined Q_OS_ANDROID
+    auto inotifyBackend = std::make_unique<InotifyWatcherBackend>(parent);
+    if (inotifyBackend->isValid()) {
+        return inotifyBackend.release();
+    }
+
+    qCInfo(orgKdeElisaIndexer()) << "FileSystemWatcherBackend::create" << "inotify is not available, falling back to QFileSystemWatcher";
+#endif
+
+    return new QtFileSystemWatcherBackend(parent);
+}
+
+
+#include "moc_filesystemwatcherbackend.cpp"
@@ -0,0 +1,75 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef FILESYSTEMWATCHERBACKEND_H
+#define FILESYSTEMWATCHERBACKEND_H
+
+#include "elisaLib_export.h"
+
+#include <QObject>
+#include <QString>
+
+#include <limits>
+
+/**
+ * Notify the file listing about changes in the watched directories and files
+ *
+ * Depending on the platform, watching a file may not cost a kernel watch: the Linux backend only
+ * watches directories and reports changes of the watched files from the events of their directory.
+ */
+class ELISALIB_EXPORT FileSystemWatcherBackend : public QObject
+{
+
+    Q_OBJECT
+
+public:
+
+    explicit FileSystemWatcherBackend(QObject *parent = nullptr);
+
+    ~FileSystemWatcherBackend() override;
+
+    /**
+     * Create the most efficient backend available on this platform
+     */
+    static FileSystemWatcherBackend *create(QObject *parent = nullptr);
+
+    /**
+     * @returns false if the directory cannot be watched
+     */
+    virtual bool addDirectory(const QString &directoryName) = 0;
+
+    /**
+     * @returns false if the file cannot be watched
+     */
+    virtual bool addFile(const QString &fileName) = 0;
+
+    /**
+     * Number of kernel watches in use: this is what the system limits
+     */
+    [[nodiscard]] virtual int watchesCount() const = 0;
+
+    /**
+     * Refuse to use more than maximumWatches kernel watches, in addition to the limit of the system
+     */
+    void setMaximumWatches(int maximumWatches);
+
+Q_SIGNALS:
+
+    void directoryChanged(const QString &path);
+
+    void fileChanged(const QString &path);
+
+protected:
+
+    [[nodiscard]] bool hasFreeWatch() const;
+
+private:
+
+    int mMaximumWatches = std::numeric_limits<int>::max();
+
+};
+
+#endif // FILESYSTEMWATCHERBACKEND_H
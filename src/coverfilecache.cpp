@@ -0,0 +1,142 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverfilecache.h"
+
+#include <QDir>
+#include <QList>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace
+{
+
+const QStringList constCoverExtensions {
+    QStringLiteral(".jpg")
+    ,QStringLiteral(".jpeg")
+    ,QStringLiteral(".png")
+    ,QStringLiteral(".webp")
+};
+
+const QStringList constCoverNames {
+    QStringLiteral("[Cc]over")
+    ,QStringLiteral("[Cc]over[Ii]mage")
+    ,QStringLiteral("[Ff]older")
+    ,QStringLiteral("[Aa]lbumart")
+};
+
+const QStringList constCoverGlobs = {
+    QStringLiteral("*[Cc]over*")
+    ,QStringLiteral("*[Ff]older*")
+    ,QStringLiteral("*[Ff]ront*")
+    ,QStringLiteral("*[Aa]lbumart*")
+};
+
+QStringList buildCoverFileNames(const QStringList &fileNames, const QStringList &fileExtensions)
+{
+    QStringList covers {};
+    for (const auto &fileName : fileNames) {
+        for (const auto &fileExtension : fileExtensions) {
+            covers.push_back(fileName + fileExtension);
+        }
+    }
+    return covers;
+}
+
+/**
+ * same matching rules as QDir name filters
+ */
+QList<QRegularExpression> buildCoverFilePatterns(const QStringList &fileNames)
+{
+    QList<QRegularExpression> patterns;
+    for (const auto &oneFileName : buildCoverFileNames(fileNames, constCoverExtensions)) {
+        patterns.push_back(QRegularExpression::fromWildcard(oneFileName, Qt::CaseInsensitive));
+    }
+    return patterns;
+}
+
+}
+
+CoverFileCache::CoverFileCache(int maximumDirectoriesCount)
+{
+    mCovers.setMaxCost(maximumDirectoriesCount);
+}
+
+QUrl CoverFileCache::coverForDirectory(const QString &directoryPath)
+{
+    auto invalidationsCount = quint64{};
+
+    {
+        QMutexLocker coversLocker(&mCoversMutex);
+        if (const auto *cover = mCovers.object(directoryPath)) {
+            return *cover;
+        }
+        invalidationsCount = mInvalidationsCount;
+    }
+
+    const auto cover = searchCoverInDirectory(directoryPath);
+
+    QMutexLocker coversLocker(&mCoversMutex);
+    if (invalidationsCount == mInvalidationsCount) {
+        mCovers.insert(directoryPath, new QUrl(cover));
+    }
+
+    return cover;
+}
+
+void CoverFileCache::invalidate(const QString &directoryPath)
+{
+    QMutexLocker coversLocker(&mCoversMutex);
+    mCovers.remove(directoryPath);
+    ++mInvalidationsCount;
+}
+
+void CoverFileCache::clear()
+{
+    QMutexLocker coversLocker(&mCoversMutex);
+    mCovers.clear();
+    ++mInvalidationsCount;
+}
+
+QUrl CoverFileCache::searchCoverInDirectory(const QString &directoryPath)
+{
+    static const auto coverFileAllImages = buildCoverFileNames({QStringLiteral("*")}, constCoverExtensions);
+    static const auto coverFileNames = buildCoverFilePatterns(constCoverNames);
+    static const auto coverFileGlobs = buildCoverFilePatterns(constCoverGlobs);
+
+    const QDir directory(directoryPath);
+
+    // the directory is listed once, the cover rules are then applied to this list
+    const auto allImages = directory.entryList(coverFileAllImages, QDir::Files, QDir::Name | QDir::IgnoreCase);
+
+    if (allImages.isEmpty()) {
+        return {};
+    }
+
+    if (allImages.size() == 1) {
+        return QUrl::fromLocalFile(directory.absoluteFilePath(allImages.first()));
+    }
+
+    const auto dirName = directory.dirName();
+    const auto coverFileDirName = buildCoverFilePatterns({QLatin1String("*") + dirName + QLatin1String("*"),
+                                                          QLatin1String("*") + QString{dirName}.remove(QLatin1Char(' ')) + QLatin1String("*")});
+
+    for (const auto *patterns : {&coverFileNames, &coverFileGlobs, &coverFileDirName}) {
+        const auto itCover = std::find_if(allImages.cbegin(), allImages.cend(), [patterns](const QString &fileName) {
+            return std::any_of(patterns->cbegin(), patterns->cend(), [&fileName](const QRegularExpression &pattern) {
+                return pattern.match(fileName).hasMatch();
+            });
+        });
+
+        if (itCover != allImages.cend()) {
+            return QUrl::fromLocalFile(directory.absoluteFilePath(*itCover));
+        }
+    }
+
+    return QUrl::fromLocalFile(directory.absoluteFilePath(allImages.first()));
+}
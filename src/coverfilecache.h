@@ -0,0 +1,54 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef COVERFILECACHE_H
+#define COVERFILECACHE_H
+
+#include "elisaLib_export.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+
+/**
+ * Bounded cache of the cover image file found in each music directory.
+ *
+ * Each directory is listed once and the cover is selected in memory. Entries must be
+ * invalidated when the content of a directory changes. It can be shared by several
+ * FileScanner used from different threads.
+ */
+class ELISALIB_EXPORT CoverFileCache
+{
+public:
+
+    explicit CoverFileCache(int maximumDirectoriesCount = 4096);
+
+    /**
+     * cover image file for the tracks of directoryPath, an empty url if there is none
+     */
+    QUrl coverForDirectory(const QString &directoryPath);
+
+    void invalidate(const QString &directoryPath);
+
+    void clear();
+
+private:
+
+    static QUrl searchCoverInDirectory(const QString &directoryPath);
+
+    QMutex mCoversMutex;
+
+    QCache<QString, QUrl> mCovers;
+
+    /**
+     * incremented on each invalidation: a cover searched while the directory changed is not cached
+     */
+    quint64 mInvalidationsCount = 0;
+
+};
+
+#endif // COVERFILECACHE_H
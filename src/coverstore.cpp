@@ -0,0 +1,185 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverstore.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace
+{
+
+/**
+ * a file records the modification time of the version the cover was read from and the hash of its image
+ */
+QByteArray linkContent(const QString &localFileName, const QByteArray &hash)
+{
+    return QByteArray::number(QFileInfo(localFileName).lastModified().toMSecsSinceEpoch()) + '\n' + hash;
+}
+
+}
+
+CoverStore::CoverStore(QString storeDirectory)
+    : mStoreDirectory(std::move(storeDirectory))
+{
+    if (mStoreDirectory.isEmpty()) {
+        mStoreDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/embeddedcovers");
+    }
+}
+
+bool CoverStore::hasThumbnailFor(const QSize &requestedSize)
+{
+    return std::max(requestedSize.width(), requestedSize.height()) <= ThumbnailSizes.back();
+}
+
+QByteArray CoverStore::storeCover(const QString &localFileName, const QByteArray &imageData) const
+{
+    if (imageData.isEmpty() || !createStoreDirectories()) {
+        return {};
+    }
+
+    const auto hash = QCryptographicHash::hash(imageData, QCryptographicHash::Sha1).toHex();
+
+    if (!QFileInfo::exists(thumbnailFileName(hash, ThumbnailSizes.back()))) {
+        const auto coverImage = QImage::fromData(imageData);
+        if (coverImage.isNull()) {
+            qCDebug(orgKdeElisaIndexer()) << "CoverStore::storeCover" << "invalid embedded cover image in" << localFileName;
+            return {};
+        }
+
+        // the largest size is written last: it marks the thumbnails of this image as complete
+        for (const auto thumbnailSize : ThumbnailSizes) {
+            auto thumbnail = coverImage;
+            if (coverImage.width() > thumbnailSize || coverImage.height() > thumbnailSize) {
+                thumbnail = coverImage.scaled(thumbnailSize, thumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            }
+
+            QSaveFile thumbnailFile(thumbnailFileName(hash, thumbnailSize));
+            if (!thumbnailFile.open(QIODevice::WriteOnly) || !thumbnail.save(&thumbnailFile, "PNG") || !thumbnailFile.commit()) {
+                qCDebug(orgKdeElisaIndexer()) << "CoverStore::storeCover" << "unable to write" << thumbnailFile.fileName();
+                return {};
+            }
+        }
+    }
+
+    const auto content = linkContent(localFileName, hash);
+
+    QSaveFile linkFile(fileLinkName(localFileName));
+    if (!linkFile.open(QIODevice::WriteOnly) || linkFile.write(content) != content.size() || !linkFile.commit()) {
+        qCDebug(orgKdeElisaIndexer()) << "CoverStore::storeCover" << "unable to write" << linkFile.fileName();
+        return {};
+    }
+
+    return hash;
+}
+
+QByteArray CoverStore::coverHash(const QString &localFileName) const
+{
+    QFile linkFile(fileLinkName(localFileName));
+    if (!linkFile.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    // a cover stored for an older version of the file is ignored
+    const auto content = linkFile.readAll();
+    const auto hashPosition = content.indexOf('\n') + 1;
+    if (hashPosition == 0 || content.left(hashPosition) != linkContent(localFileName, {})) {
+        return {};
+    }
+
+    return content.mid(hashPosition);
+}
+
+QImage CoverStore::cover(const QString &localFileName, const QSize &requestedSize) const
+{
+    const auto requestedDimension = std::max(requestedSize.width(), requestedSize.height());
+    const auto itSize = std::find_if(ThumbnailSizes.begin(), ThumbnailSizes.end(), [requestedDimension](int size) {
+        return size >= requestedDimension;
+    });
+
+    if (itSize == ThumbnailSizes.end()) {
+        return {};
+    }
+
+    const auto hash = coverHash(localFileName);
+    if (hash.isEmpty()) {
+        return {};
+    }
+
+    return QImage{thumbnailFileName(hash, *itSize), "PNG"};
+}
+
+int CoverStore::removeCovers(const QList<QUrl> &removedFiles) const
+{
+    auto removedCoversCount = 0;
+
+    for (const auto &oneFile : removedFiles) {
+        if (oneFile.isLocalFile() && QFile::remove(fileLinkName(oneFile.toLocalFile()))) {
+            ++removedCoversCount;
+        }
+    }
+
+    return removedCoversCount;
+}
+
+void CoverStore::removeUnusedThumbnails() const
+{
+    auto usedHashes = QSet<QByteArray>{};
+
+    const auto allLinks = QDir(mStoreDirectory + QStringLiteral("/files")).entryInfoList(QDir::Files);
+    for (const auto &oneLink : allLinks) {
+        QFile linkFile(oneLink.absoluteFilePath());
+        if (linkFile.open(QIODevice::ReadOnly)) {
+            const auto content = linkFile.readAll();
+            usedHashes.insert(content.mid(content.indexOf('\n') + 1));
+        }
+    }
+
+    // a cover being stored concurrently may lose its thumbnails: they are written again the next time it is stored
+    auto removedThumbnailsCount = 0;
+    const auto allThumbnails = QDir(mStoreDirectory + QStringLiteral("/thumbnails")).entryInfoList({QStringLiteral("*.png")}, QDir::Files);
+    for (const auto &oneThumbnail : allThumbnails) {
+        if (!usedHashes.contains(oneThumbnail.fileName().section(QLatin1Char('-'), 0, 0).toLatin1()) &&
+                QFile::remove(oneThumbnail.absoluteFilePath())) {
+            ++removedThumbnailsCount;
+        }
+    }
+
+    qCDebug(orgKdeElisaIndexer()) << "CoverStore::removeUnusedThumbnails" << removedThumbnailsCount << "thumbnails removed";
+}
+
+QString CoverStore::thumbnailFileName(const QByteArray &hash, int size) const
+{
+    return QStringLiteral("%1/thumbnails/%2-%3.png").arg(mStoreDirectory, QString::fromLatin1(hash)).arg(size);
+}
+
+QString CoverStore::fileLinkName(const QString &localFileName) const
+{
+    const auto fileKey = QFileInfo(localFileName).absoluteFilePath();
+
+    return mStoreDirectory + QStringLiteral("/files/") + QString::fromLatin1(QCryptographicHash::hash(fileKey.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+bool CoverStore::createStoreDirectories() const
+{
+    if (mHasStoreDirectories) {
+        return true;
+    }
+
+    mHasStoreDirectories = QDir().mkpath(mStoreDirectory + QStringLiteral("/thumbnails")) && QDir().mkpath(mStoreDirectory + QStringLiteral("/files"));
+
+    return mHasStoreDirectories;
+}
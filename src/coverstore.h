@@ -0,0 +1,92 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef COVERSTORE_H
+#define COVERSTORE_H
+
+#include "elisaLib_export.h"
+
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QUrl>
+
+#include <array>
+#include <atomic>
+
+/**
+ * On-disk store of pre-scaled embedded cover thumbnails.
+ *
+ * Thumbnails are stored once per distinct image, named after the hash of the
+ * encoded image data. Each audio file only records the hash of its cover, so
+ * albums using the same art for every track store the thumbnails once.
+ *
+ * The store directories are only created when a first cover is stored. All
+ * methods only use the file system and can be called from any thread.
+ */
+class ELISALIB_EXPORT CoverStore
+{
+public:
+
+    static constexpr std::array<int, 3> ThumbnailSizes = {64, 128, 256};
+
+    explicit CoverStore(QString storeDirectory = {});
+
+    /**
+     * true if a thumbnail of the store covers requestedSize
+     */
+    [[nodiscard]] static bool hasThumbnailFor(const QSize &requestedSize);
+
+    /**
+     * store the thumbnails of the encoded image embedded in localFileName
+     * the image is only decoded and scaled when no other file already stored it
+     *
+     * @return the hash identifying the stored image, or an empty array on failure
+     */
+    QByteArray storeCover(const QString &localFileName, const QByteArray &imageData) const;
+
+    /**
+     * hash of the image stored for the current version of localFileName, empty if none
+     */
+    [[nodiscard]] QByteArray coverHash(const QString &localFileName) const;
+
+    /**
+     * smallest stored thumbnail of localFileName covering requestedSize
+     *
+     * @return a null image if nothing is stored for this file or requestedSize is larger than every thumbnail
+     */
+    [[nodiscard]] QImage cover(const QString &localFileName, const QSize &requestedSize) const;
+
+    /**
+     * forget the covers of removedFiles, their thumbnails are kept until removeUnusedThumbnails
+     *
+     * @return the number of files that had a stored cover
+     */
+    int removeCovers(const QList<QUrl> &removedFiles) const;
+
+    /**
+     * remove the thumbnails of the images no file refers to anymore
+     * it reads the cover of every file: call it once a batch of covers has been removed
+     */
+    void removeUnusedThumbnails() const;
+
+private:
+
+    [[nodiscard]] QString thumbnailFileName(const QByteArray &hash, int size) const;
+
+    [[nodiscard]] QString fileLinkName(const QString &localFileName) const;
+
+    bool createStoreDirectories() const;
+
+    QString mStoreDirectory;
+
+    mutable std::atomic<bool> mHasStoreDirectories = false;
+
+};
+
+#endif // COVERSTORE_H
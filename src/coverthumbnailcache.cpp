@@ -0,0 +1,139 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverthumbnailcache.h"
+
+#include "viewsLogging.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+CoverThumbnailCache::CoverThumbnailCache(QString cacheDirectory, qint64 maximumDiskBytes)
+    : mCacheDirectory(std::move(cacheDirectory)), mMaximumDiskBytes(maximumDiskBytes)
+{
+    if (mCacheDirectory.isEmpty()) {
+        mCacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/covers");
+    }
+
+    mMemoryCache.setMaxCost(MemoryCacheMaxKiloBytes);
+    QDir().mkpath(mCacheDirectory);
+}
+
+QString CoverThumbnailCache::cacheKey(const QString &fileName, const QSize &size)
+{
+    const QFileInfo fileInfo(fileName);
+    const auto keyData = QStringLiteral("%1\n%2\n%3\n%4x%5").arg(fileInfo.absoluteFilePath())
+                             .arg(fileInfo.lastModified().toMSecsSinceEpoch())
+                             .arg(fileInfo.size())
+                             .arg(size.width())
+                             .arg(size.height());
+
+    return QString::fromLatin1(QCryptographicHash::hash(keyData.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QImage CoverThumbnailCache::image(const QString &key)
+{
+    {
+        QMutexLocker memoryCacheLocker(&mMemoryCacheMutex);
+        if (const auto *cachedImage = mMemoryCache.object(key)) {
+            ++mHits;
+            return *cachedImage;
+        }
+    }
+
+    auto result = QImage{};
+    QFile cacheFile(cacheFileName(key));
+    if (cacheFile.open(QIODevice::ReadOnly) && result.load(&cacheFile, "PNG")) {
+        // the modification time records the last use of a thumbnail for pruning
+        cacheFile.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+
+        ++mHits;
+        insertInMemoryCache(key, result);
+        return result;
+    }
+
+    ++mMisses;
+    return {};
+}
+
+void CoverThumbnailCache::insert(const QString &key, const QImage &image, Storage storage)
+{
+    insertInMemoryCache(key, image);
+
+    if (storage == MemoryOnly) {
+        return;
+    }
+
+    QSaveFile cacheFile(cacheFileName(key));
+    if (!cacheFile.open(QIODevice::WriteOnly) || !image.save(&cacheFile, "PNG") || !cacheFile.commit()) {
+        qCDebug(orgKdeElisaViews()) << "CoverThumbnailCache::insert" << "unable to write" << cacheFile.fileName();
+        return;
+    }
+
+    auto needsPruning = false;
+    {
+        QMutexLocker diskCacheLocker(&mDiskCacheMutex);
+        mDiskBytes += QFileInfo(cacheFile.fileName()).size();
+        needsPruning = mDiskBytes > mMaximumDiskBytes;
+    }
+
+    if (needsPruning) {
+        prune();
+    }
+}
+
+void CoverThumbnailCache::prune()
+{
+    QMutexLocker diskCacheLocker(&mDiskCacheMutex);
+
+    // least recently used thumbnails first
+    const auto allThumbnails = QDir(mCacheDirectory).entryInfoList({QStringLiteral("*.png")}, QDir::Files, QDir::Time | QDir::Reversed);
+
+    mDiskBytes = 0;
+    for (const auto &oneThumbnail : allThumbnails) {
+        mDiskBytes += oneThumbnail.size();
+    }
+
+    for (const auto &oneThumbnail : allThumbnails) {
+        if (mDiskBytes <= mMaximumDiskBytes) {
+            break;
+        }
+
+        if (QFile::remove(oneThumbnail.absoluteFilePath())) {
+            mDiskBytes -= oneThumbnail.size();
+        }
+    }
+
+    qCDebug(orgKdeElisaViews()) << "CoverThumbnailCache::prune" << mDiskBytes << "bytes of thumbnails in" << mCacheDirectory;
+}
+
+quint64 CoverThumbnailCache::hits() const
+{
+    return mHits;
+}
+
+quint64 CoverThumbnailCache::misses() const
+{
+    return mMisses;
+}
+
+QString CoverThumbnailCache::cacheFileName(const QString &key) const
+{
+    return mCacheDirectory + QLatin1Char('/') + key + QStringLiteral(".png");
+}
+
+void CoverThumbnailCache::insertInMemoryCache(const QString &key, const QImage &image)
+{
+    QMutexLocker memoryCacheLocker(&mMemoryCacheMutex);
+    mMemoryCache.insert(key, new QImage(image), std::max<int>(1, static_cast<int>(image.sizeInBytes() / 1024)));
+}
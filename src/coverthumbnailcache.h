@@ -0,0 +1,96 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef COVERTHUMBNAILCACHE_H
+#define COVERTHUMBNAILCACHE_H
+
+#include "elisaLib_export.h"
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+#include <atomic>
+
+/**
+ * In-memory and on-disk cache of the cover thumbnails shown by the views.
+ *
+ * A thumbnail is keyed by the file it comes from, the modification time and size of this
+ * file and the requested size: a modified file never gets a stale thumbnail. The on-disk
+ * part is bounded, the least recently used thumbnails are removed once it grows larger
+ * than its maximum size.
+ *
+ * All methods can be called from any thread.
+ */
+class ELISALIB_EXPORT CoverThumbnailCache
+{
+public:
+
+    static constexpr qint64 DefaultMaximumDiskBytes = 256 * 1024 * 1024;
+
+    enum Storage {
+        MemoryOnly,
+        MemoryAndDisk,
+    };
+
+    explicit CoverThumbnailCache(QString cacheDirectory = {}, qint64 maximumDiskBytes = DefaultMaximumDiskBytes);
+
+    /**
+     * the key identifies one thumbnail of one version of a file
+     * modifying the file or asking another size gives another key
+     */
+    static QString cacheKey(const QString &fileName, const QSize &size);
+
+    /**
+     * cached thumbnail for key, a null image if there is none
+     */
+    QImage image(const QString &key);
+
+    /**
+     * thumbnails that are already stored on disk elsewhere, like in CoverStore, are only kept in memory
+     */
+    void insert(const QString &key, const QImage &image, Storage storage = MemoryAndDisk);
+
+    /**
+     * remove the least recently used thumbnails until the on-disk cache fits in its maximum size
+     */
+    void prune();
+
+    [[nodiscard]] quint64 hits() const;
+
+    [[nodiscard]] quint64 misses() const;
+
+private:
+
+    static constexpr int MemoryCacheMaxKiloBytes = 64 * 1024;
+
+    [[nodiscard]] QString cacheFileName(const QString &key) const;
+
+    void insertInMemoryCache(const QString &key, const QImage &image);
+
+    QString mCacheDirectory;
+
+    qint64 mMaximumDiskBytes = DefaultMaximumDiskBytes;
+
+    QMutex mMemoryCacheMutex;
+
+    QCache<QString, QImage> mMemoryCache;
+
+    QMutex mDiskCacheMutex;
+
+    /**
+     * size of the on-disk thumbnails, as measured by the last prune and updated on insertion
+     */
+    qint64 mDiskBytes = 0;
+
+    std::atomic<quint64> mHits = 0;
+
+    std::atomic<quint64> mMisses = 0;
+};
+
+#endif // COVERTHUMBNAILCACHE_H
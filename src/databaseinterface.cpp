@@ -19,20 +19,91 @@
 #include <QSqlError>
 
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QMutex>
 #include <QVariant>
 #include <QAtomicInt>
 #include <QElapsedTimer>
+#include <QTimer>
+#include <QThread>
 #include <QDebug>
 
 #ifdef Q_OS_ANDROID
 #include <QOperatingSystemVersion>
 #endif
 
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 
 using namespace Qt::Literals::StringLiterals;
 
+/**
+ * Format database ids as a JSON array that can be bound to a single `json_each` parameter
+ */
+static QString databaseIdsToJsonArray(const QSet<qulonglong> &databaseIds)
+{
+    auto result = QStringList{};
+    result.reserve(databaseIds.size());
+
+    for (auto oneId : databaseIds) {
+        result.push_back(QString::number(oneId));
+    }
+
+    return QLatin1Char('[') + result.join(QLatin1Char(',')) + QLatin1Char(']');
+}
+
+/**
+ * Format file names as a JSON array that can be bound to a single `json_each` parameter
+ */
+static QString fileNamesToJsonArray(const QList<QUrl> &fileNames)
+{
+    auto result = QJsonArray{};
+
+    for (const auto &oneFileName : fileNames) {
+        result.push_back(oneFileName.toString());
+    }
+
+    return QString::fromUtf8(QJsonDocument{result}.toJson(QJsonDocument::Compact));
+}
+
+/**
+ * Words of searchText that can be found in the full text index
+ */
+static QStringList searchTextWords(const QString &searchText)
+{
+    auto result = searchText.normalized(QString::NormalizationForm_KC).simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    // words without any letter or digit are not indexed
+    result.removeIf([](const QString &oneWord) {
+        return std::none_of(oneWord.cbegin(), oneWord.cend(), [](QChar oneCharacter) { return oneCharacter.isLetterOrNumber(); });
+    });
+
+    return result;
+}
+
+/**
+ * Build a full text search expression matching words starting with each word of searchText in any of columns
+ */
+static QString searchTextToMatchExpression(const QString &searchText, const QString &columns)
+{
+    auto result = QStringList{};
+
+    const auto words = searchTextWords(searchText);
+    for (auto oneWord : words) {
+        result.push_back(columns + QLatin1String(" : \"") + oneWord.replace(QLatin1Char('"'), QLatin1String("\"\"")) + QLatin1String("\"*"));
+    }
+
+    return result.join(QLatin1String(" AND "));
+}
+
 class DatabaseInterfacePrivate
 {
 public:
@@ -120,6 +191,7 @@ public:
         , mConnectionName(connectionName)
         , mDatabaseFileName(databaseFileName)
         , mSelectAlbumQuery(mTracksDatabase)
+        , mSelectAlbumsFromIdsQuery(mTracksDatabase)
         , mSelectTrackQuery(mTracksDatabase)
         , mSelectAlbumIdFromTitleQuery(mTracksDatabase)
         , mInsertAlbumQuery(mTracksDatabase)
@@ -129,6 +201,7 @@ public:
         , mSelectTracksFromGenre(mTracksDatabase)
         , mSelectTracksFromArtistAndGenre(mTracksDatabase)
         , mSelectTrackFromIdQuery(mTracksDatabase)
+        , mSelectTracksFromIdsQuery(mTracksDatabase)
         , mSelectRadioFromIdQuery(mTracksDatabase)
         , mSelectCountAlbumsForArtistQuery(mTracksDatabase)
         , mSelectTrackIdFromTitleArtistAlbumTrackDiscNumberQuery(mTracksDatabase)
@@ -137,6 +210,7 @@ public:
         , mInsertArtistsQuery(mTracksDatabase)
         , mSelectArtistByNameQuery(mTracksDatabase)
         , mSelectArtistQuery(mTracksDatabase)
+        , mSelectArtistsFromIdsQuery(mTracksDatabase)
         , mUpdateTrackStartedStatistics(mTracksDatabase)
         , mUpdateTrackFinishedStatistics(mTracksDatabase)
         , mRemoveTrackQuery(mTracksDatabase)
@@ -154,10 +228,12 @@ public:
         , mUpdateTrackPriority(mTracksDatabase)
         , mUpdateTrackFileModifiedTime(mTracksDatabase)
         , mSelectTracksMapping(mTracksDatabase)
+        , mSelectTracksMappingFromFileNames(mTracksDatabase)
         , mSelectTracksMappingPriority(mTracksDatabase)
         , mSelectRadioIdFromHttpAddress(mTracksDatabase)
         , mUpdateAlbumArtUriFromAlbumIdQuery(mTracksDatabase)
         , mSelectUpToFourLatestCoversFromArtistNameQuery(mTracksDatabase)
+        , mSelectUpToFourLatestCoversFromArtistIdsQuery(mTracksDatabase)
         , mSelectTracksMappingPriorityByTrackId(mTracksDatabase)
         , mSelectAlbumIdsFromArtist(mTracksDatabase)
         , mSelectAllTrackFilesQuery(mTracksDatabase)
@@ -215,10 +291,17 @@ public:
         , mSelectTrackFromIdAndUrlQuery(mTracksDatabase)
         , mUpdateDatabaseVersionQuery(mTracksDatabase)
         , mSelectDatabaseVersionQuery(mTracksDatabase)
-        , mArtistHasTracksQuery(mTracksDatabase)
-        , mGenreHasTracksQuery(mTracksDatabase)
-        , mComposerHasTracksQuery(mTracksDatabase)
-        , mLyricistHasTracksQuery(mTracksDatabase)
+        , mSelectOrphanArtistsQuery(mTracksDatabase)
+        , mSelectOrphanGenresQuery(mTracksDatabase)
+        , mSelectOrphanComposersQuery(mTracksDatabase)
+        , mSelectOrphanLyricistsQuery(mTracksDatabase)
+        , mSelectRemovedTracksFromFileNames(mTracksDatabase)
+        , mRemoveTracksFromFileNames(mTracksDatabase)
+        , mRemoveTracksMappingFromFileNames(mTracksDatabase)
+        , mSelectEmptyAlbumsFromIds(mTracksDatabase)
+        , mRemoveEmptyAlbumsFromIds(mTracksDatabase)
+        , mSelectTracksIdsMatchingSearchQuery(mTracksDatabase)
+        , mSelectAlbumsIdsMatchingSearchQuery(mTracksDatabase)
     {
     }
 
@@ -230,6 +313,8 @@ public:
 
     QSqlQuery mSelectAlbumQuery;
 
+    QSqlQuery mSelectAlbumsFromIdsQuery;
+
     QSqlQuery mSelectTrackQuery;
 
     QSqlQuery mSelectAlbumIdFromTitleQuery;
@@ -248,6 +333,8 @@ public:
 
     QSqlQuery mSelectTrackFromIdQuery;
 
+    QSqlQuery mSelectTracksFromIdsQuery;
+
     QSqlQuery mSelectRadioFromIdQuery;
 
     QSqlQuery mSelectCountAlbumsForArtistQuery;
@@ -264,6 +351,8 @@ public:
 
     QSqlQuery mSelectArtistQuery;
 
+    QSqlQuery mSelectArtistsFromIdsQuery;
+
     QSqlQuery mUpdateTrackStartedStatistics;
 
     QSqlQuery mUpdateTrackFinishedStatistics;
@@ -293,6 +382,8 @@ public:
 
     QSqlQuery mSelectTracksMapping;
 
+    QSqlQuery mSelectTracksMappingFromFileNames;
+
     QSqlQuery mSelectTracksMappingPriority;
 
     QSqlQuery mSelectRadioIdFromHttpAddress;
@@ -301,6 +392,8 @@ public:
 
     QSqlQuery mSelectUpToFourLatestCoversFromArtistNameQuery;
 
+    QSqlQuery mSelectUpToFourLatestCoversFromArtistIdsQuery;
+
     QSqlQuery mSelectTracksMappingPriorityByTrackId;
 
     QSqlQuery mSelectAlbumIdsFromArtist;
@@ -415,10 +508,24 @@ public:
 
     QSqlQuery mSelectDatabaseVersionQuery;
 
-    QSqlQuery mArtistHasTracksQuery;
-    QSqlQuery mGenreHasTracksQuery;
-    QSqlQuery mComposerHasTracksQuery;
-    QSqlQuery mLyricistHasTracksQuery;
+    QSqlQuery mSelectOrphanArtistsQuery;
+    QSqlQuery mSelectOrphanGenresQuery;
+    QSqlQuery mSelectOrphanComposersQuery;
+    QSqlQuery mSelectOrphanLyricistsQuery;
+
+    QSqlQuery mSelectRemovedTracksFromFileNames;
+
+    QSqlQuery mRemoveTracksFromFileNames;
+
+    QSqlQuery mRemoveTracksMappingFromFileNames;
+
+    QSqlQuery mSelectEmptyAlbumsFromIds;
+
+    QSqlQuery mRemoveEmptyAlbumsFromIds;
+
+    QSqlQuery mSelectTracksIdsMatchingSearchQuery;
+
+    QSqlQuery mSelectAlbumsIdsMatchingSearchQuery;
 
     QSet<qulonglong> mInsertedTracks;
     QSet<qulonglong> mInsertedRadios;
@@ -461,7 +568,62 @@ public:
 
     bool mInitFinished = false;
 
-    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V17;
+    qulonglong mExecutedQueriesCount = 0;
+
+    qulonglong mInsertedDataFetchQueriesCount = 0;
+
+    /**
+     * smaller lists of removed files are removed one by one
+     */
+    static constexpr int BulkTracksRemovalMinimumSize = 100;
+
+    /**
+     * delay without new play event before buffered events are written
+     */
+    static constexpr int PlayStatisticsFlushDelay = 3000;
+
+    static constexpr int PlayStatisticsMaximumBatchSize = 100;
+
+    struct PlayStatisticsEvent {
+        QUrl mFileName;
+        QDateTime mTime;
+        bool mHasFinished = false;
+    };
+
+    /**
+     * play events not yet written to the database, each one is also in mPlayStatisticsJournal
+     */
+    QList<PlayStatisticsEvent> mPendingPlayStatistics;
+
+    QTimer mPlayStatisticsTimer;
+
+    /**
+     * append-only log of the pending play events, replayed on next start after a crash
+     * each event is only handed to the OS: a power loss can lose the events of the last few seconds
+     */
+    QFile mPlayStatisticsJournal;
+
+    /**
+     * push the journal to the disk: QFile::flush only hands it to the OS, which may lose it on a system crash
+     */
+    void syncPlayStatisticsJournal()
+    {
+        if (!mPlayStatisticsJournal.flush()) {
+            return;
+        }
+#ifdef Q_OS_WIN
+        _commit(mPlayStatisticsJournal.handle());
+#else
+        fsync(mPlayStatisticsJournal.handle());
+#endif
+    }
+
+    /**
+     * written by the database thread, read by the models from the GUI thread
+     */
+    std::atomic_bool mHasSearchIndex = false;
+
+    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V18;
 
     struct TableSchema {
         QString name;
@@ -535,11 +697,26 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
     initDataQueries();
 
+    // write play events once playback is idle instead of one transaction per event
+    d->mPlayStatisticsTimer.setSingleShot(true);
+    d->mPlayStatisticsTimer.setInterval(DatabaseInterfacePrivate::PlayStatisticsFlushDelay);
+    connect(&d->mPlayStatisticsTimer, &QTimer::timeout, this, &DatabaseInterface::flushPlayStatistics);
+
     if (!databaseFileName.isEmpty()) {
+        d->mPlayStatisticsJournal.setFileName(databaseFileName + u"-statistics"_s);
+        replayPlayStatisticsJournal();
+
         reloadExistingDatabase();
     }
 }
 
+void DatabaseInterface::initReadOnly(const QString &dbName, const QString &databaseFileName)
+{
+    initConnection(dbName, databaseFileName, true);
+
+    initDataQueries();
+}
+
 qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
 {
     auto result = qulonglong{0};
@@ -613,6 +790,8 @@ DataTypes::ListTrackDataType DatabaseInterface::recentlyPlayedTracksData(int cou
         return result;
     }
 
+    flushPlayStatistics();
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return result;
@@ -636,6 +815,8 @@ DataTypes::ListTrackDataType DatabaseInterface::frequentlyPlayedTracksData(int c
         return result;
     }
 
+    flushPlayStatistics();
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return result;
@@ -1075,6 +1256,57 @@ qulonglong DatabaseInterface::trackIdFromTitleAlbumTrackDiscNumber(const QString
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromDatabaseIds(const QList<qulonglong> &ids)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    const auto allTracks = internalTracksPartialData(QSet<qulonglong>(ids.cbegin(), ids.cend()));
+
+    result.reserve(allTracks.size());
+    std::copy_if(allTracks.cbegin(), allTracks.cend(), std::back_inserter(result), [](const auto &oneTrack) {
+        return !oneTrack.isEmpty();
+    });
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+QHash<QUrl, qulonglong> DatabaseInterface::trackIdsFromFileNames(const QList<QUrl> &fileNames)
+{
+    auto result = QHash<QUrl, qulonglong>{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalTrackIdsFromFileNames(fileNames);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 qulonglong DatabaseInterface::trackIdFromFileName(const QUrl &fileName)
 {
     auto result = qulonglong(0);
@@ -1121,9 +1353,49 @@ qulonglong DatabaseInterface::radioIdFromFileName(const QUrl &fileName)
     return result;
 }
 
+bool DatabaseInterface::canSearchData(ElisaUtils::PlayListEntryType dataType) const
+{
+    return d && d->mHasSearchIndex && (dataType == ElisaUtils::Track || dataType == ElisaUtils::Album);
+}
+
+bool DatabaseInterface::isSearchableText(const QString &searchText)
+{
+    return !searchTextWords(searchText).isEmpty();
+}
+
+QList<qulonglong> DatabaseInterface::databaseIdsMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    auto result = QList<qulonglong>{};
+
+    if (!canSearchData(dataType)) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    result = internalDatabaseIdsMatchingSearch(dataType, searchText);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 void DatabaseInterface::applicationAboutToQuit()
 {
     d->mStopRequest = 1;
+
+    // buffered play events are written before the database thread stops
+    if (thread() == QThread::currentThread()) {
+        flushPlayStatistics();
+    } else {
+        QMetaObject::invokeMethod(this, &DatabaseInterface::flushPlayStatistics, Qt::BlockingQueuedConnection);
+    }
 }
 
 void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks)
@@ -1183,11 +1455,10 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
 
     pruneCollections();
 
-    DataTypes::ListTrackDataType newTracks;
-    for (auto trackId : std::as_const(d->mInsertedTracks)) {
-        newTracks.push_back(internalOneTrackPartialData(trackId));
-        d->mModifiedTrackIds.remove(trackId);
-    }
+    const auto queriesCountBeforeFetch = d->mExecutedQueriesCount;
+
+    auto newTracks = internalTracksPartialData(d->mInsertedTracks);
+    d->mModifiedTrackIds.subtract(d->mInsertedTracks);
 
     DataTypes::ListRadioDataType newRadios;
     for (auto radioId : std::as_const(d->mInsertedRadios)) {
@@ -1195,16 +1466,10 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         d->mModifiedRadioIds.remove(radioId);
     }
 
-    DataTypes::ListAlbumDataType newAlbums;
-    for (auto albumId : std::as_const(d->mInsertedAlbums)) {
-        newAlbums.push_back(internalOneAlbumPartialData(albumId));
-        d->mModifiedAlbumIds.remove(albumId);
-    }
+    auto newAlbums = internalAlbumsPartialData(d->mInsertedAlbums);
+    d->mModifiedAlbumIds.subtract(d->mInsertedAlbums);
 
-    DataTypes::ListArtistDataType newArtists;
-    for (auto newArtistId : std::as_const(d->mInsertedArtists)) {
-        newArtists.push_back(internalOneArtistPartialData(newArtistId));
-    }
+    auto newArtists = internalArtistsPartialData(d->mInsertedArtists);
 
     DataTypes::ListGenreDataType newGenres;
     for (auto newGenreId : std::as_const(d->mInsertedGenres)) {
@@ -1221,16 +1486,15 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         newLyricists.push_back(internalOneLyricistPartialData(newComposerId));
     }
 
-    DataTypes::ListTrackDataType modifiedTracks;
-    for (auto trackId : std::as_const(d->mModifiedTrackIds)) {
-        modifiedTracks.push_back(internalOneTrackPartialData(trackId));
-    }
+    auto modifiedTracks = internalTracksPartialData(d->mModifiedTrackIds);
 
     DataTypes::ListRadioDataType modifiedRadios;
     for (auto radioId : std::as_const(d->mModifiedRadioIds)) {
         modifiedRadios.push_back(internalOneRadioPartialData(radioId));
     }
 
+    d->mInsertedDataFetchQueriesCount = d->mExecutedQueriesCount - queriesCountBeforeFetch;
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         Q_EMIT finishInsertingTracksList();
@@ -1326,32 +1590,12 @@ void DatabaseInterface::askRestoredTracks()
 
 void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
 {
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return;
-    }
-
-    updateTrackStartedStatistics(fileName, time);
-
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    bufferPlayStatistics(fileName, time, false);
 }
 
 void DatabaseInterface::trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time)
 {
-    auto transactionResult = startTransaction();
-    if (!transactionResult) {
-        return;
-    }
-
-    updateTrackFinishedStatistics(fileName, time);
-
-    transactionResult = finishTransaction();
-    if (!transactionResult) {
-        return;
-    }
+    bufferPlayStatistics(fileName, time, true);
 }
 
 void DatabaseInterface::clearData()
@@ -1455,7 +1699,7 @@ void DatabaseInterface::clearData()
 
 /********* Init and upgrade methods *********/
 
-void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName)
+void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName, bool readOnly)
 {
     QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
 
@@ -1464,7 +1708,11 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
     } else {
         tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    if (readOnly) {
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    } else {
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    }
 
     auto result = tracksDatabase.open();
     if (result) {
@@ -1476,6 +1724,11 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
 
     QSqlQuery{u"PRAGMA foreign_keys = ON;"_s, tracksDatabase}.exec();
 
+    // write-ahead logging lets the read-only view connections read while the indexer writes
+    if (!readOnly && !databaseFileName.isEmpty()) {
+        QSqlQuery{u"PRAGMA journal_mode = WAL;"_s, tracksDatabase}.exec();
+    }
+
     d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase, connectionName, databaseFileName);
 }
 
@@ -3551,6 +3804,62 @@ UPDATE Radios SET HttpAddress='https://icecast.radiofrance.fr/francemusique-lofi
 
 void DatabaseInterface::upgradeDatabaseV17()
 {
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v17 of database schema";
+
+    createTracksSearchIndex();
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v17 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV18()
+{
+}
+
+void DatabaseInterface::createTracksSearchIndex()
+{
+    // the index is optional: searching falls back to filtering in the views when SQLite lacks FTS5
+    const QStringList sqlStatements = {
+        uR"(
+CREATE VIRTUAL TABLE `TracksSearch` USING fts5(
+`Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, 
+`Genre`, `Composer`, `Lyricist`, 
+content='Tracks', content_rowid='ID', 
+tokenize='unicode61 remove_diacritics 2')
+)"_s,
+        uR"(
+CREATE TRIGGER `TracksSearchInsert` AFTER INSERT ON `Tracks` BEGIN 
+INSERT INTO `TracksSearch`(rowid, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) 
+VALUES (new.`ID`, new.`Title`, new.`ArtistName`, new.`AlbumArtistName`, new.`AlbumTitle`, new.`Genre`, new.`Composer`, new.`Lyricist`); 
+END
+)"_s,
+        uR"(
+CREATE TRIGGER `TracksSearchDelete` AFTER DELETE ON `Tracks` BEGIN 
+INSERT INTO `TracksSearch`(`TracksSearch`, rowid, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) 
+VALUES ('delete', old.`ID`, old.`Title`, old.`ArtistName`, old.`AlbumArtistName`, old.`AlbumTitle`, old.`Genre`, old.`Composer`, old.`Lyricist`); 
+END
+)"_s,
+        uR"(
+CREATE TRIGGER `TracksSearchUpdate` 
+AFTER UPDATE OF `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist` ON `Tracks` BEGIN 
+INSERT INTO `TracksSearch`(`TracksSearch`, rowid, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) 
+VALUES ('delete', old.`ID`, old.`Title`, old.`ArtistName`, old.`AlbumArtistName`, old.`AlbumTitle`, old.`Genre`, old.`Composer`, old.`Lyricist`); 
+INSERT INTO `TracksSearch`(rowid, `Title`, `ArtistName`, `AlbumArtistName`, `AlbumTitle`, `Genre`, `Composer`, `Lyricist`) 
+VALUES (new.`ID`, new.`Title`, new.`ArtistName`, new.`AlbumArtistName`, new.`AlbumTitle`, new.`Genre`, new.`Composer`, new.`Lyricist`); 
+END
+)"_s,
+        u"INSERT INTO `TracksSearch`(`TracksSearch`) VALUES ('rebuild')"_s,
+    };
+
+    QSqlQuery sqlQuery(d->mTracksDatabase);
+
+    for (const auto &oneSqlStatement : sqlStatements) {
+        if (!sqlQuery.exec(oneSqlStatement)) {
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastQuery();
+            qCWarning(orgKdeElisaDatabase) << __FUNCTION__ << sqlQuery.lastError();
+
+            return;
+        }
+    }
 }
 
 DatabaseInterface::DatabaseState DatabaseInterface::checkDatabaseSchema() const
@@ -3597,6 +3906,9 @@ bool DatabaseInterface::resetDatabase()
         return false;
     }
 
+    QFile::remove(databaseFileName + QStringLiteral("-wal"));
+    QFile::remove(databaseFileName + QStringLiteral("-shm"));
+
     initConnection(connectionName, databaseFileName);
     return true;
 }
@@ -3785,6 +4097,9 @@ void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVe
     case DatabaseInterface::V17:
         upgradeDatabaseV17();
         break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
     }
 }
 
@@ -3840,6 +4155,16 @@ bool DatabaseInterface::rollBackTransaction()
     return result;
 }
 
+qulonglong DatabaseInterface::executedQueriesCount() const
+{
+    return d->mExecutedQueriesCount;
+}
+
+qulonglong DatabaseInterface::insertedDataFetchQueriesCount() const
+{
+    return d->mInsertedDataFetchQueriesCount;
+}
+
 bool DatabaseInterface::prepareQuery(QSqlQuery &query, const QString &queryText) const
 {
     query.setForwardOnly(true);
@@ -3854,6 +4179,7 @@ bool DatabaseInterface::execQuery(QSqlQuery &query)
 #endif
 
     auto result = query.exec();
+    ++d->mExecutedQueriesCount;
 
 #if !defined NDEBUG
     if (timer.nsecsElapsed() > 10000000) {
@@ -3953,6 +4279,18 @@ GROUP BY album.`ID`
 
             Q_EMIT databaseError();
         }
+
+        auto selectAlbumsFromIdsQueryText = selectAlbumQueryText;
+        selectAlbumsFromIdsQueryText.replace(u"album.`ID` = :albumId"_s, u"album.`ID` IN (SELECT `value` FROM json_each(:albumIds))"_s);
+
+        result = prepareQuery(d->mSelectAlbumsFromIdsQuery, selectAlbumsFromIdsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromIdsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
     }
 
     {
@@ -5425,6 +5763,18 @@ tracksMapping.`FileName` = tracks.`FileName`
 
             Q_EMIT databaseError();
         }
+
+        auto selectTracksFromIdsQueryText = selectTrackFromIdQueryText;
+        selectTracksFromIdsQueryText.replace(u"tracks.`ID` = :trackId"_s, u"tracks.`ID` IN (SELECT `value` FROM json_each(:trackIds))"_s);
+
+        result = prepareQuery(d->mSelectTracksFromIdsQuery, selectTracksFromIdsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromIdsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
     }
 
     {
@@ -5885,31 +6235,156 @@ WHERE `FileName` = :fileName
 
             Q_EMIT databaseError();
         }
+
+        auto removeTracksMappingFromFileNamesQueryText = removeTracksMappingQueryText;
+        removeTracksMappingFromFileNamesQueryText.replace(u"`FileName` = :fileName"_s, u"`FileName` IN (SELECT `value` FROM json_each(:fileNames))"_s);
+
+        result = prepareQuery(d->mRemoveTracksMappingFromFileNames, removeTracksMappingFromFileNamesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMappingFromFileNames.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksMappingFromFileNames.lastError();
+
+            Q_EMIT databaseError();
+        }
     }
 
     {
-        auto selectTracksWithoutMappingQueryText =
+        auto removeTracksFromFileNamesQueryText =
+            uR"(
+DELETE FROM `Tracks` 
+WHERE 
+`FileName` IN (SELECT `value` FROM json_each(:fileNames))
+)"_s;
+
+        auto result = prepareQuery(d->mRemoveTracksFromFileNames, removeTracksFromFileNamesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksFromFileNames.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveTracksFromFileNames.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectRemovedTracksFromFileNamesQueryText =
             uR"(
 SELECT 
-tracks.`Id`, 
-tracks.`Title`, 
+tracks.`ID`, 
 album.`ID`, 
-tracks.`ArtistName`, 
-( 
-SELECT 
-COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) 
+artist.`ID`, 
+albumArtist.`ID`, 
+genre.`ID`, 
+composer.`ID`, 
+lyricist.`ID` 
 FROM 
-`Tracks` tracksFromAlbum1 
+`TracksData` trackData 
+INNER JOIN 
+`Tracks` tracks 
+ON 
+tracks.`FileName` = trackData.`FileName` 
+LEFT JOIN 
+`Albums` album 
+ON 
+album.`Title` = tracks.`AlbumTitle` AND 
+(album.`ArtistName` = tracks.`AlbumArtistName` OR tracks.`AlbumArtistName` IS NULL OR album.`ArtistName` IS NULL) AND 
+album.`AlbumPath` = tracks.`AlbumPath` 
+LEFT JOIN 
+`Artists` artist 
+ON 
+artist.`Name` = tracks.`ArtistName` 
+LEFT JOIN 
+`Artists` albumArtist 
+ON 
+albumArtist.`Name` = tracks.`AlbumArtistName` 
+LEFT JOIN 
+`Genre` genre 
+ON 
+genre.`Name` = tracks.`Genre` 
+LEFT JOIN 
+`Composer` composer 
+ON 
+composer.`Name` = tracks.`Composer` 
+LEFT JOIN 
+`Lyricist` lyricist 
+ON 
+lyricist.`Name` = tracks.`Lyricist` 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
-) AS ArtistsCount, 
-( 
+trackData.`FileName` IN (SELECT `value` FROM json_each(:fileNames))
+)"_s;
+
+        auto result = prepareQuery(d->mSelectRemovedTracksFromFileNames, selectRemovedTracksFromFileNamesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRemovedTracksFromFileNames.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectRemovedTracksFromFileNames.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        // albums among :albumIds that no track refers to any more
+        const auto emptyAlbumsFromIdsCondition =
+            uR"(
+`ID` IN (SELECT `value` FROM json_each(:albumIds)) AND 
+NOT EXISTS (
+     SELECT 
+     1 
+     FROM 
+     `Tracks` tracks, 
+     `TracksData` tracksMapping 
+     WHERE 
+     tracksMapping.`FileName` = tracks.`FileName` AND 
+     tracks.`AlbumTitle` = `Albums`.`Title` AND 
+     (tracks.`AlbumArtistName` = `Albums`.`ArtistName` OR tracks.`AlbumArtistName` IS NULL) AND 
+     tracks.`AlbumPath` = `Albums`.`AlbumPath`
+)
+)"_s;
+
+        auto result = prepareQuery(d->mSelectEmptyAlbumsFromIds, u"SELECT `ID` FROM `Albums` WHERE "_s + emptyAlbumsFromIdsCondition);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectEmptyAlbumsFromIds.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectEmptyAlbumsFromIds.lastError();
+
+            Q_EMIT databaseError();
+        }
+
+        result = prepareQuery(d->mRemoveEmptyAlbumsFromIds, u"DELETE FROM `Albums` WHERE "_s + emptyAlbumsFromIdsCondition);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveEmptyAlbumsFromIds.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveEmptyAlbumsFromIds.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectTracksWithoutMappingQueryText =
+            uR"(
+SELECT 
+tracks.`Id`, 
+tracks.`Title`, 
+album.`ID`, 
+tracks.`ArtistName`, 
+( 
+SELECT 
+COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) 
+FROM 
+`Tracks` tracksFromAlbum1 
+WHERE 
+tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
+(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
+(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL 
+) 
+) AND 
+tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+) AS ArtistsCount, 
+( 
 SELECT 
 GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) 
 FROM 
@@ -6032,6 +6507,18 @@ trackData.`FileName` = :fileName
 
             Q_EMIT databaseError();
         }
+
+        auto selectTracksMappingFromFileNamesQueryText = selectTracksMappingQueryText;
+        selectTracksMappingFromFileNamesQueryText.replace(u"trackData.`FileName` = :fileName"_s, u"trackData.`FileName` IN (SELECT `value` FROM json_each(:fileNames))"_s);
+
+        result = prepareQuery(d->mSelectTracksMappingFromFileNames, selectTracksMappingFromFileNamesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingFromFileNames.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksMappingFromFileNames.lastError();
+
+            Q_EMIT databaseError();
+        }
     }
 
     {
@@ -6643,6 +7130,62 @@ LIMIT 4
         }
     }
 
+    {
+        auto selectUpToFourLatestCoversFromArtistIdsQueryText =
+            uR"(
+SELECT 
+rankedCovers.`ArtistId`, 
+rankedCovers.`CoverFileName`, 
+rankedCovers.`IsTrackCover` 
+FROM 
+(
+SELECT 
+albumCovers.`ArtistId`, 
+albumCovers.`CoverFileName`, 
+albumCovers.`IsTrackCover`, 
+ROW_NUMBER() OVER (PARTITION BY albumCovers.`ArtistId` ORDER BY albumCovers.`Year` DESC) AS CoverRank 
+FROM 
+(
+SELECT 
+artist.`ID` AS ArtistId, 
+(CASE WHEN (album.`CoverFileName` IS NOT NULL AND 
+album.`CoverFileName` IS NOT '') THEN album.`CoverFileName` 
+ELSE track.`FileName` END) AS CoverFileName, 
+(album.`CoverFileName` IS NULL OR 
+album.`CoverFileName` IS '') AS IsTrackCover, 
+track.`Year` 
+FROM 
+`Artists` artist 
+INNER JOIN `Tracks` track ON 
+(track.`ArtistName` = artist.`Name` OR 
+track.`AlbumArtistName` = artist.`Name`) 
+LEFT OUTER JOIN `Albums` album ON 
+album.`Title` = track.`AlbumTitle` AND 
+album.`ArtistName` = track.`AlbumArtistName` AND 
+album.`AlbumPath` = track.`AlbumPath` 
+WHERE 
+artist.`ID` IN (SELECT `value` FROM json_each(:artistIds)) AND 
+(track.`HasEmbeddedCover` = 1 OR 
+(album.`CoverFileName` IS NOT NULL AND 
+album.`CoverFileName` IS NOT '')) 
+GROUP BY artist.`ID`, track.`AlbumTitle` 
+) albumCovers 
+) rankedCovers 
+WHERE 
+rankedCovers.`CoverRank` <= 4 
+ORDER BY rankedCovers.`ArtistId`, rankedCovers.`CoverRank` 
+)"_s;
+
+        auto result = prepareQuery(d->mSelectUpToFourLatestCoversFromArtistIdsQuery, selectUpToFourLatestCoversFromArtistIdsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectUpToFourLatestCoversFromArtistIdsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectUpToFourLatestCoversFromArtistIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto selectTracksFromArtistQueryText =
             uR"(
@@ -7094,6 +7637,18 @@ WHERE
 
             Q_EMIT databaseError();
         }
+
+        auto selectArtistsFromIdsQueryText = selectArtistQueryText;
+        selectArtistsFromIdsQueryText.replace(u"`ID` = :artistId"_s, u"`ID` IN (SELECT `value` FROM json_each(:artistIds))"_s);
+
+        result = prepareQuery(d->mSelectArtistsFromIdsQuery, selectArtistsFromIdsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistsFromIdsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistsFromIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
     }
 
     {
@@ -7258,7 +7813,7 @@ WHERE
             uR"(
 DELETE FROM `Artists` 
 WHERE 
-`ID` = :artistId
+`ID` IN (SELECT `value` FROM json_each(:artistIds))
 )"_s;
 
         auto result = prepareQuery(d->mRemoveArtistQuery, removeArtistQueryText);
@@ -7276,7 +7831,7 @@ WHERE
             uR"(
 DELETE FROM `Genre` 
 WHERE 
-`ID` = :genreId
+`ID` IN (SELECT `value` FROM json_each(:genreIds))
 )"_s;
 
         auto result = prepareQuery(d->mRemoveGenreQuery, removeGenreQueryText);
@@ -7294,7 +7849,7 @@ WHERE
             uR"(
 DELETE FROM `Composer` 
 WHERE 
-`ID` = :composerId
+`ID` IN (SELECT `value` FROM json_each(:composerIds))
 )"_s;
 
         auto result = prepareQuery(d->mRemoveComposerQuery, removeComposerQueryText);
@@ -7312,7 +7867,7 @@ WHERE
             uR"(
 DELETE FROM `Lyricist` 
 WHERE 
-`ID` = :lyricistId
+`ID` IN (SELECT `value` FROM json_each(:lyricistIds))
 )"_s;
 
         auto result = prepareQuery(d->mRemoveLyricistQuery, removeLyricistQueryText);
@@ -7326,86 +7881,142 @@ WHERE
     }
 
     {
-        const auto artistHasTracks =
+        auto selectOrphanArtistsQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
+SELECT artists.`ID` 
+FROM `Artists` artists 
+WHERE artists.`ID` IN (SELECT `value` FROM json_each(:artistIds)) AND 
+NOT EXISTS(SELECT 1 
 FROM `Tracks` 
-INNER JOIN `Artists` artists on 
-(`ArtistName` = artists.`Name` 
-OR `AlbumArtistName` = artists.`Name`) 
-WHERE artists.`ID` = :artistId)
+WHERE `ArtistName` = artists.`Name` 
+OR `AlbumArtistName` = artists.`Name`)
 )"_s;
 
-        const auto result = prepareQuery(d->mArtistHasTracksQuery, artistHasTracks);
+        auto result = prepareQuery(d->mSelectOrphanArtistsQuery, selectOrphanArtistsQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mArtistHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mArtistHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanArtistsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanArtistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        const auto genreHasTracks =
+        auto selectOrphanGenresQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
+SELECT genres.`ID` 
+FROM `Genre` genres 
+WHERE genres.`ID` IN (SELECT `value` FROM json_each(:genreIds)) AND 
+NOT EXISTS(SELECT 1 
 FROM `Tracks` 
-INNER JOIN `Genre` genres on 
-`Genre` = genres.`Name` 
-WHERE genres.`ID` = :genreId)
+WHERE `Genre` = genres.`Name`)
 )"_s;
 
-        const auto result = prepareQuery(d->mGenreHasTracksQuery, genreHasTracks);
+        auto result = prepareQuery(d->mSelectOrphanGenresQuery, selectOrphanGenresQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mGenreHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mGenreHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanGenresQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanGenresQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        const auto composerHasTracks =
+        auto selectOrphanComposersQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
+SELECT composers.`ID` 
+FROM `Composer` composers 
+WHERE composers.`ID` IN (SELECT `value` FROM json_each(:composerIds)) AND 
+NOT EXISTS(SELECT 1 
 FROM `Tracks` 
-INNER JOIN `Composer` composers on 
-`Composer` = composers.`Name` 
-WHERE composers.`ID` = :composerId)
+WHERE `Composer` = composers.`Name`)
 )"_s;
 
-        const auto result = prepareQuery(d->mComposerHasTracksQuery, composerHasTracks);
+        auto result = prepareQuery(d->mSelectOrphanComposersQuery, selectOrphanComposersQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mComposerHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mComposerHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanComposersQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanComposersQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        const auto lyricistHasTracks =
+        auto selectOrphanLyricistsQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
+SELECT lyricists.`ID` 
+FROM `Lyricist` lyricists 
+WHERE lyricists.`ID` IN (SELECT `value` FROM json_each(:lyricistIds)) AND 
+NOT EXISTS(SELECT 1 
 FROM `Tracks` 
-INNER JOIN `Lyricist` lyricists on 
-`Lyricist` = lyricists.`Name` 
-WHERE lyricists.`ID` = :lyricistId)
+WHERE `Lyricist` = lyricists.`Name`)
 )"_s;
 
-        const auto result = prepareQuery(d->mLyricistHasTracksQuery, lyricistHasTracks);
+        auto result = prepareQuery(d->mSelectOrphanLyricistsQuery, selectOrphanLyricistsQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mLyricistHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mLyricistHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanLyricistsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mSelectOrphanLyricistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
+    d->mHasSearchIndex = d->mTracksDatabase.tables().contains(u"TracksSearch"_s);
+
+    if (d->mHasSearchIndex) {
+        const auto selectTracksIdsMatchingSearchQueryText =
+            uR"(
+SELECT 
+`TracksSearch`.rowid 
+FROM 
+`TracksSearch` 
+WHERE 
+`TracksSearch` MATCH :search
+)"_s;
+
+        auto result = prepareQuery(d->mSelectTracksIdsMatchingSearchQuery, selectTracksIdsMatchingSearchQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksIdsMatchingSearchQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksIdsMatchingSearchQuery.lastError();
+
+            d->mHasSearchIndex = false;
+        }
+
+        const auto selectAlbumsIdsMatchingSearchQueryText =
+            uR"(
+SELECT DISTINCT 
+album.`ID` 
+FROM 
+`TracksSearch` 
+INNER JOIN 
+`Tracks` tracks 
+ON 
+tracks.`ID` = `TracksSearch`.rowid 
+INNER JOIN 
+`Albums` album 
+ON 
+tracks.`AlbumTitle` = album.`Title` AND 
+(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
+tracks.`AlbumPath` = album.`AlbumPath` 
+WHERE 
+`TracksSearch` MATCH :search
+)"_s;
+
+        result = prepareQuery(d->mSelectAlbumsIdsMatchingSearchQuery, selectAlbumsIdsMatchingSearchQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsIdsMatchingSearchQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsIdsMatchingSearchQuery.lastError();
+
+            d->mHasSearchIndex = false;
+        }
+    }
+
     finishTransaction();
 
     d->mInitFinished = true;
@@ -8109,6 +8720,8 @@ DataTypes::TrackDataType DatabaseInterface::buildTrackDataFromDatabaseRecord(con
         result[DataTypes::TrackDataType::key_type::LyricistRole] = trackRecord.value(DatabaseInterfacePrivate::TrackLyricistName);
     }
 
+    result.internMetaDataStrings();
+
     return result;
 }
 
@@ -8140,67 +8753,196 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
             QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
             QUrl::RemoveScheme | QUrl::RemoveUserInfo;
 
-    for (const auto &removedTrackFileName : removedTracks) {
-        auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
+    const auto updateModifiedAlbum = [this, &currentOptions](qulonglong modifiedAlbumId) {
+        const auto modifiedAlbum = internalOneAlbumData(modifiedAlbumId);
+        if (updateAlbumFromId(modifiedAlbumId, modifiedAlbum.at(0).albumCover(), modifiedAlbum.at(0), modifiedAlbum.at(0).resourceURI().toString(currentOptions))) {
+            for (const auto &oneTrack : modifiedAlbum) {
+                recordModifiedTrack(oneTrack.databaseId());
+            }
+        }
+
+        d->mModifiedAlbumIds.insert(modifiedAlbumId);
+    };
+
+    if (removedTracks.size() >= DatabaseInterfacePrivate::BulkTracksRemovalMinimumSize) {
+        modifiedAlbums = internalBulkRemoveTracksList(removedTracks);
+
+        const auto removedAlbums = internalBulkRemoveEmptyAlbums(modifiedAlbums);
+        d->mRemovedAlbumIds.unite(removedAlbums);
+        modifiedAlbums.subtract(removedAlbums);
+
+        // the albums left in modifiedAlbums still have tracks
+        for (auto modifiedAlbumId : std::as_const(modifiedAlbums)) {
+            updateModifiedAlbum(modifiedAlbumId);
+        }
+    } else {
+        for (const auto &removedTrackFileName : removedTracks) {
+            auto removedTrackId = internalTrackIdFromFileName(removedTrackFileName);
+
+            d->mRemovedTrackIds.insert(removedTrackId);
+
+            auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
+
+            removeTrackInDatabase(removedTrackId);
+
+            const auto &trackPath = oneRemovedTrack.resourceURI().toString(currentOptions);
+            const auto &modifiedAlbumId = internalAlbumIdFromTitleAndArtist(oneRemovedTrack.album(), oneRemovedTrack.albumArtist(), trackPath);
+
+            if (modifiedAlbumId) {
+                recordModifiedAlbum(modifiedAlbumId);
+                modifiedAlbums.insert(modifiedAlbumId);
+            }
 
-        d->mRemovedTrackIds.insert(removedTrackId);
+            d->mPossiblyRemovedArtistIds.insert(internalArtistIdFromName(oneRemovedTrack.artist()));
+            if (oneRemovedTrack.albumArtist() != oneRemovedTrack.artist()) {
+                d->mPossiblyRemovedArtistIds.insert(internalArtistIdFromName(oneRemovedTrack.albumArtist()));
+            }
+            d->mPossiblyRemovedGenreIds.insert(internalGenreIdFromName(oneRemovedTrack.genre()));
+            d->mPossiblyRemovedComposerIds.insert(internalComposerIdFromName(oneRemovedTrack.composer()));
+            d->mPossiblyRemovedLyricistsIds.insert(internalLyricistIdFromName(oneRemovedTrack.lyricist()));
+
+            d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
+
+            auto result = execQuery(d->mRemoveTracksMapping);
+
+            if (!result || !d->mRemoveTracksMapping.isActive()) {
+                Q_EMIT databaseError();
 
-        auto oneRemovedTrack = internalTrackFromDatabaseId(removedTrackId);
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
 
-        removeTrackInDatabase(removedTrackId);
+                continue;
+            }
 
-        const auto &trackPath = oneRemovedTrack.resourceURI().toString(currentOptions);
-        const auto &modifiedAlbumId = internalAlbumIdFromTitleAndArtist(oneRemovedTrack.album(), oneRemovedTrack.albumArtist(), trackPath);
+            d->mRemoveTracksMapping.finish();
+        }
 
+        for (auto modifiedAlbumId : modifiedAlbums) {
+            const auto &modifiedAlbumData = internalOneAlbumPartialData(modifiedAlbumId);
+
+            auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
+
+            if (!modifiedAlbumData.isEmpty() && tracksCount) {
+                updateModifiedAlbum(modifiedAlbumId);
+            } else {
+                removeAlbumInDatabase(modifiedAlbumId);
+                d->mRemovedAlbumIds.insert(modifiedAlbumId);
+            }
+        }
+    }
+}
+
+QSet<qulonglong> DatabaseInterface::internalBulkRemoveTracksList(const QList<QUrl> &removedTracks)
+{
+    auto modifiedAlbums = QSet<qulonglong>{};
+
+    const auto fileNames = fileNamesToJsonArray(removedTracks);
+
+    d->mSelectRemovedTracksFromFileNames.bindValue(QStringLiteral(":fileNames"), fileNames);
+
+    auto result = execQuery(d->mSelectRemovedTracksFromFileNames);
+
+    if (!result || !d->mSelectRemovedTracksFromFileNames.isSelect() || !d->mSelectRemovedTracksFromFileNames.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveTracksList" << d->mSelectRemovedTracksFromFileNames.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveTracksList" << d->mSelectRemovedTracksFromFileNames.lastError();
+
+        d->mSelectRemovedTracksFromFileNames.finish();
+
+        return modifiedAlbums;
+    }
+
+    while (d->mSelectRemovedTracksFromFileNames.next()) {
+        const auto &currentRecord = d->mSelectRemovedTracksFromFileNames.record();
+
+        d->mRemovedTrackIds.insert(currentRecord.value(0).toULongLong());
+
+        const auto modifiedAlbumId = currentRecord.value(1).toULongLong();
         if (modifiedAlbumId) {
             recordModifiedAlbum(modifiedAlbumId);
             modifiedAlbums.insert(modifiedAlbumId);
         }
 
-        d->mPossiblyRemovedArtistIds.insert(internalArtistIdFromName(oneRemovedTrack.artist()));
-        if (oneRemovedTrack.albumArtist() != oneRemovedTrack.artist()) {
-            d->mPossiblyRemovedArtistIds.insert(internalArtistIdFromName(oneRemovedTrack.albumArtist()));
-        }
-        d->mPossiblyRemovedGenreIds.insert(internalGenreIdFromName(oneRemovedTrack.genre()));
-        d->mPossiblyRemovedComposerIds.insert(internalComposerIdFromName(oneRemovedTrack.composer()));
-        d->mPossiblyRemovedLyricistsIds.insert(internalLyricistIdFromName(oneRemovedTrack.lyricist()));
+        d->mPossiblyRemovedArtistIds.insert(currentRecord.value(2).toULongLong());
+        d->mPossiblyRemovedArtistIds.insert(currentRecord.value(3).toULongLong());
+        d->mPossiblyRemovedGenreIds.insert(currentRecord.value(4).toULongLong());
+        d->mPossiblyRemovedComposerIds.insert(currentRecord.value(5).toULongLong());
+        d->mPossiblyRemovedLyricistsIds.insert(currentRecord.value(6).toULongLong());
+    }
 
-        d->mRemoveTracksMapping.bindValue(QStringLiteral(":fileName"), removedTrackFileName.toString());
+    d->mSelectRemovedTracksFromFileNames.finish();
 
-        auto result = execQuery(d->mRemoveTracksMapping);
+    for (auto *removeQuery : {&d->mRemoveTracksFromFileNames, &d->mRemoveTracksMappingFromFileNames}) {
+        removeQuery->bindValue(QStringLiteral(":fileNames"), fileNames);
 
-        if (!result || !d->mRemoveTracksMapping.isActive()) {
-            Q_EMIT databaseError();
+        result = execQuery(*removeQuery);
 
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.boundValues();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalRemoveTracksList" << d->mRemoveTracksMapping.lastError();
+        if (!result || !removeQuery->isActive()) {
+            Q_EMIT databaseError();
 
-            continue;
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveTracksList" << removeQuery->lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveTracksList" << removeQuery->lastError();
         }
 
-        d->mRemoveTracksMapping.finish();
+        removeQuery->finish();
     }
 
-    for (auto modifiedAlbumId : modifiedAlbums) {
-        const auto &modifiedAlbumData = internalOneAlbumPartialData(modifiedAlbumId);
+    return modifiedAlbums;
+}
 
-        auto tracksCount = fetchTrackIds(modifiedAlbumId).count();
+QSet<qulonglong> DatabaseInterface::internalBulkRemoveEmptyAlbums(const QSet<qulonglong> &albumIds)
+{
+    auto removedAlbums = QSet<qulonglong>{};
 
-        if (!modifiedAlbumData.isEmpty() && tracksCount) {
-            const auto modifiedAlbum = internalOneAlbumData(modifiedAlbumId);
-            if (updateAlbumFromId(modifiedAlbumId, modifiedAlbum.at(0).albumCover(), modifiedAlbum.at(0), modifiedAlbum.at(0).resourceURI().toString(currentOptions))) {
-                for (const auto &oneTrack : modifiedAlbum) {
-                    recordModifiedTrack(oneTrack.databaseId());
-                }
-            }
+    if (albumIds.isEmpty()) {
+        return removedAlbums;
+    }
 
-            d->mModifiedAlbumIds.insert(modifiedAlbumId);
-        } else {
-            removeAlbumInDatabase(modifiedAlbumId);
-            d->mRemovedAlbumIds.insert(modifiedAlbumId);
-        }
+    const auto albumIdsArray = databaseIdsToJsonArray(albumIds);
+
+    d->mSelectEmptyAlbumsFromIds.bindValue(QStringLiteral(":albumIds"), albumIdsArray);
+
+    auto result = execQuery(d->mSelectEmptyAlbumsFromIds);
+
+    if (!result || !d->mSelectEmptyAlbumsFromIds.isSelect() || !d->mSelectEmptyAlbumsFromIds.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveEmptyAlbums" << d->mSelectEmptyAlbumsFromIds.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveEmptyAlbums" << d->mSelectEmptyAlbumsFromIds.lastError();
+
+        d->mSelectEmptyAlbumsFromIds.finish();
+
+        return removedAlbums;
+    }
+
+    while (d->mSelectEmptyAlbumsFromIds.next()) {
+        removedAlbums.insert(d->mSelectEmptyAlbumsFromIds.record().value(0).toULongLong());
+    }
+
+    d->mSelectEmptyAlbumsFromIds.finish();
+
+    if (removedAlbums.isEmpty()) {
+        return removedAlbums;
     }
+
+    d->mRemoveEmptyAlbumsFromIds.bindValue(QStringLiteral(":albumIds"), albumIdsArray);
+
+    result = execQuery(d->mRemoveEmptyAlbumsFromIds);
+
+    if (!result || !d->mRemoveEmptyAlbumsFromIds.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveEmptyAlbums" << d->mRemoveEmptyAlbumsFromIds.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkRemoveEmptyAlbums" << d->mRemoveEmptyAlbumsFromIds.lastError();
+
+        removedAlbums.clear();
+    }
+
+    d->mRemoveEmptyAlbumsFromIds.finish();
+
+    return removedAlbums;
 }
 
 QUrl DatabaseInterface::internalAlbumArtUriFromAlbumId(qulonglong albumId)
@@ -8565,74 +9307,6 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
     d->mRemoveAlbumQuery.finish();
 }
 
-void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
-{
-    d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
-
-    auto result = execQuery(d->mRemoveArtistQuery);
-
-    if (!result || !d->mRemoveArtistQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
-    }
-
-    d->mRemoveArtistQuery.finish();
-}
-
-void DatabaseInterface::removeGenreInDatabase(qulonglong genreId)
-{
-    d->mRemoveGenreQuery.bindValue(QStringLiteral(":genreId"), genreId);
-
-    auto result = execQuery(d->mRemoveGenreQuery);
-
-    if (!result || !d->mRemoveGenreQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.lastError();
-    }
-
-    d->mRemoveGenreQuery.finish();
-}
-
-void DatabaseInterface::removeComposerInDatabase(qulonglong composerId)
-{
-    d->mRemoveComposerQuery.bindValue(QStringLiteral(":composerId"), composerId);
-
-    auto result = execQuery(d->mRemoveComposerQuery);
-
-    if (!result || !d->mRemoveComposerQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.lastError();
-    }
-
-    d->mRemoveComposerQuery.finish();
-}
-
-void DatabaseInterface::removeLyricistInDatabase(qulonglong lyricistId)
-{
-    d->mRemoveLyricistQuery.bindValue(QStringLiteral(":lyricistId"), lyricistId);
-
-    auto result = execQuery(d->mRemoveLyricistQuery);
-
-    if (!result || !d->mRemoveLyricistQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.lastError();
-    }
-
-    d->mRemoveLyricistQuery.finish();
-}
-
 void DatabaseInterface::reloadExistingDatabase()
 {
     qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
@@ -8948,6 +9622,82 @@ qulonglong DatabaseInterface::internalTrackIdFromFileName(const QUrl &fileName)
     return result;
 }
 
+QHash<QUrl, qulonglong> DatabaseInterface::internalTrackIdsFromFileNames(const QList<QUrl> &fileNames)
+{
+    auto result = QHash<QUrl, qulonglong>{};
+
+    if (!d || fileNames.isEmpty()) {
+        return result;
+    }
+
+    d->mSelectTracksMappingFromFileNames.bindValue(QStringLiteral(":fileNames"), fileNamesToJsonArray(fileNames));
+
+    auto queryResult = execQuery(d->mSelectTracksMappingFromFileNames);
+
+    if (!queryResult || !d->mSelectTracksMappingFromFileNames.isSelect() || !d->mSelectTracksMappingFromFileNames.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << d->mSelectTracksMappingFromFileNames.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << d->mSelectTracksMappingFromFileNames.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalTrackIdsFromFileNames" << d->mSelectTracksMappingFromFileNames.lastError();
+
+        d->mSelectTracksMappingFromFileNames.finish();
+
+        return result;
+    }
+
+    result.reserve(fileNames.size());
+    while (d->mSelectTracksMappingFromFileNames.next()) {
+        const auto &currentRecord = d->mSelectTracksMappingFromFileNames.record();
+        const auto trackId = currentRecord.value(0).toULongLong();
+        if (trackId != 0) {
+            result.insert(QUrl{currentRecord.value(1).toString()}, trackId);
+        }
+    }
+
+    d->mSelectTracksMappingFromFileNames.finish();
+
+    return result;
+}
+
+QList<qulonglong> DatabaseInterface::internalDatabaseIdsMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    auto result = QList<qulonglong>{};
+
+    // the columns are the ones shown by the views for each type of data
+    const auto isAlbumSearch = dataType == ElisaUtils::Album;
+    auto &searchQuery = isAlbumSearch ? d->mSelectAlbumsIdsMatchingSearchQuery : d->mSelectTracksIdsMatchingSearchQuery;
+    const auto matchExpression = searchTextToMatchExpression(searchText, isAlbumSearch ?
+                                                                 u"{AlbumTitle AlbumArtistName ArtistName}"_s :
+                                                                 u"{Title ArtistName AlbumTitle AlbumArtistName}"_s);
+
+    if (matchExpression.isEmpty()) {
+        return result;
+    }
+
+    searchQuery.bindValue(QStringLiteral(":search"), matchExpression);
+
+    auto queryResult = execQuery(searchQuery);
+
+    if (!queryResult || !searchQuery.isSelect() || !searchQuery.isActive()) {
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalDatabaseIdsMatchingSearch" << searchQuery.lastQuery();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalDatabaseIdsMatchingSearch" << searchQuery.boundValues();
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::internalDatabaseIdsMatchingSearch" << searchQuery.lastError();
+
+        searchQuery.finish();
+
+        return result;
+    }
+
+    while (searchQuery.next()) {
+        result.push_back(searchQuery.record().value(0).toULongLong());
+    }
+
+    searchQuery.finish();
+
+    return result;
+}
+
 qulonglong DatabaseInterface::internalRadioIdFromHttpAddress(const QString &httpAddress)
 {
     auto result = qulonglong(0);
@@ -9118,11 +9868,6 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
         newData[DataTypes::TitleRole] = currentRecord.value(1);
         newData[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
         newData[DataTypes::TracksCountRole] = currentRecord.value(3);
-
-        const auto covers = internalGetLatestFourCoversForArtist(currentRecord.value(1).toString());
-        newData[DataTypes::MultipleImageUrlsRole] = covers;
-        newData[DataTypes::ImageUrlRole] = covers.value(0).toUrl();
-
         newData[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
 
         result.push_back(newData);
@@ -9130,6 +9875,19 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllArtistsPartialData(Q
 
     artistsQuery.finish();
 
+    auto artistIds = QSet<qulonglong>{};
+    artistIds.reserve(result.size());
+    for (const auto &oneArtist : std::as_const(result)) {
+        artistIds.insert(oneArtist.databaseId());
+    }
+
+    const auto coversByArtist = internalGetLatestFourCoversForArtists(artistIds);
+    for (auto &oneArtist : result) {
+        const auto covers = coversByArtist.value(oneArtist.databaseId());
+        oneArtist[DataTypes::MultipleImageUrlsRole] = covers;
+        oneArtist[DataTypes::ImageUrlRole] = covers.value(0).toUrl();
+    }
+
     return result;
 }
 
@@ -9216,6 +9974,42 @@ DataTypes::ListTrackDataType DatabaseInterface::internalOneAlbumData(qulonglong
     return result;
 }
 
+DataTypes::AlbumDataType DatabaseInterface::buildAlbumDataFromDatabaseRecord(const QSqlRecord &albumRecord) const
+{
+    auto result = DataTypes::AlbumDataType{};
+
+    result[DataTypes::DatabaseIdRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumId);
+    result[DataTypes::TitleRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumTitle);
+    if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName).toString().isEmpty()) {
+        result[DataTypes::ImageUrlRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName);
+    } else if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toString().isEmpty()) {
+        result[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + albumRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toUrl().toLocalFile()};
+    }
+
+    auto allArtists = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumAllArtists).toString().split(QStringLiteral(", "));
+    allArtists.removeDuplicates();
+    result[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
+
+    if (!albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).isNull()) {
+        result[DataTypes::IsValidAlbumArtistRole] = true;
+        result[DataTypes::SecondaryTextRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName);
+    } else {
+        result[DataTypes::IsValidAlbumArtistRole] = false;
+        if (albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() == 1) {
+            result[DataTypes::SecondaryTextRole] = allArtists.first();
+        } else if (albumRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() > 1) {
+            result[DataTypes::SecondaryTextRole] = i18nc("@item:intable", "Various Artists");
+        }
+    }
+    result[DataTypes::ArtistRole] = result[DataTypes::SecondaryTextRole];
+    result[DataTypes::HighestTrackRating] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumHighestRating);
+    result[DataTypes::IsSingleDiscAlbumRole] = albumRecord.value(DatabaseInterfacePrivate::SingleAlbumIsSingleDiscAlbum);
+    result[DataTypes::GenreRole] = QVariant::fromValue(albumRecord.value(DatabaseInterfacePrivate::SingleAlbumAllGenres).toString().split(QStringLiteral(", ")));
+    result[DataTypes::ElementTypeRole] = ElisaUtils::Album;
+
+    return result;
+}
+
 DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglong databaseId)
 {
     auto result = DataTypes::AlbumDataType{};
@@ -9227,40 +10021,40 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
     }
 
     if (d->mSelectAlbumQuery.next()) {
-        const auto &currentRecord = d->mSelectAlbumQuery.record();
+        result = buildAlbumDataFromDatabaseRecord(d->mSelectAlbumQuery.record());
+    }
 
-        result[DataTypes::DatabaseIdRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumId);
-        result[DataTypes::TitleRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumTitle);
-        if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName).toString().isEmpty()) {
-            result[DataTypes::ImageUrlRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumCoverFileName);
-        } else if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toString().isEmpty()) {
-            result[DataTypes::ImageUrlRole] = QVariant{QLatin1String("image://cover/") + currentRecord.value(DatabaseInterfacePrivate::SingleAlbumEmbeddedCover).toUrl().toLocalFile()};
-        }
+    d->mSelectAlbumQuery.finish();
 
-        auto allArtists = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumAllArtists).toString().split(QStringLiteral(", "));
-        allArtists.removeDuplicates();
-        result[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
+    return result;
+}
 
-        if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).isNull()) {
-            result[DataTypes::IsValidAlbumArtistRole] = true;
-            result[DataTypes::SecondaryTextRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName);
-        } else {
-            result[DataTypes::IsValidAlbumArtistRole] = false;
-            if (currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() == 1) {
-                result[DataTypes::SecondaryTextRole] = allArtists.first();
-            } else if (currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() > 1) {
-                result[DataTypes::SecondaryTextRole] = i18nc("@item:intable", "Various Artists");
-            }
-        }
-        result[DataTypes::ArtistRole] = result[DataTypes::SecondaryTextRole];
-        result[DataTypes::HighestTrackRating] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumHighestRating);
-        result[DataTypes::IsSingleDiscAlbumRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumIsSingleDiscAlbum);
-        result[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(DatabaseInterfacePrivate::SingleAlbumAllGenres).toString().split(QStringLiteral(", ")));
-        result[DataTypes::ElementTypeRole] = ElisaUtils::Album;
+DataTypes::ListAlbumDataType DatabaseInterface::internalAlbumsPartialData(const QSet<qulonglong> &databaseIds)
+{
+    auto result = DataTypes::ListAlbumDataType{};
 
+    if (databaseIds.isEmpty()) {
+        return result;
     }
 
-    d->mSelectAlbumQuery.finish();
+    d->mSelectAlbumsFromIdsQuery.bindValue(QStringLiteral(":albumIds"), databaseIdsToJsonArray(databaseIds));
+
+    if (!internalGenericPartialData(d->mSelectAlbumsFromIdsQuery)) {
+        return result;
+    }
+
+    auto albumsById = QHash<qulonglong, DataTypes::AlbumDataType>{};
+    while (d->mSelectAlbumsFromIdsQuery.next()) {
+        auto oneAlbum = buildAlbumDataFromDatabaseRecord(d->mSelectAlbumsFromIdsQuery.record());
+        albumsById.insert(oneAlbum.databaseId(), oneAlbum);
+    }
+
+    d->mSelectAlbumsFromIdsQuery.finish();
+
+    result.reserve(databaseIds.size());
+    for (auto albumId : databaseIds) {
+        result.push_back(albumsById.value(albumId));
+    }
 
     return result;
 }
@@ -9294,6 +10088,53 @@ DataTypes::ArtistDataType DatabaseInterface::internalOneArtistPartialData(qulong
     return result;
 }
 
+DataTypes::ListArtistDataType DatabaseInterface::internalArtistsPartialData(const QSet<qulonglong> &databaseIds)
+{
+    auto result = DataTypes::ListArtistDataType{};
+
+    if (databaseIds.isEmpty()) {
+        return result;
+    }
+
+    d->mSelectArtistsFromIdsQuery.bindValue(QStringLiteral(":artistIds"), databaseIdsToJsonArray(databaseIds));
+
+    if (!internalGenericPartialData(d->mSelectArtistsFromIdsQuery)) {
+        return result;
+    }
+
+    auto artistsById = QHash<qulonglong, DataTypes::ArtistDataType>{};
+    while (d->mSelectArtistsFromIdsQuery.next()) {
+        const auto &currentRecord = d->mSelectArtistsFromIdsQuery.record();
+
+        auto oneArtist = DataTypes::ArtistDataType{};
+        oneArtist[DataTypes::DatabaseIdRole] = currentRecord.value(0);
+        oneArtist[DataTypes::TitleRole] = currentRecord.value(1);
+        oneArtist[DataTypes::GenreRole] = QVariant::fromValue(currentRecord.value(2).toString().split(QStringLiteral(", ")));
+        oneArtist[DataTypes::ElementTypeRole] = ElisaUtils::Artist;
+
+        artistsById.insert(currentRecord.value(0).toULongLong(), oneArtist);
+    }
+
+    d->mSelectArtistsFromIdsQuery.finish();
+
+    const auto coversByArtist = internalGetLatestFourCoversForArtists(databaseIds);
+
+    result.reserve(databaseIds.size());
+    for (auto artistId : databaseIds) {
+        auto oneArtist = artistsById.value(artistId);
+
+        if (!oneArtist.isEmpty()) {
+            const auto covers = coversByArtist.value(artistId);
+            oneArtist[DataTypes::MultipleImageUrlsRole] = covers;
+            oneArtist[DataTypes::ImageUrlRole] = covers.value(0).toUrl();
+        }
+
+        result.push_back(oneArtist);
+    }
+
+    return result;
+}
+
 DataTypes::GenreDataType DatabaseInterface::internalOneGenrePartialData(qulonglong databaseId)
 {
     DataTypes::GenreDataType result;
@@ -9472,6 +10313,37 @@ DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialData(qulonglo
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::internalTracksPartialData(const QSet<qulonglong> &databaseIds)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (databaseIds.isEmpty()) {
+        return result;
+    }
+
+    d->mSelectTracksFromIdsQuery.bindValue(QStringLiteral(":trackIds"), databaseIdsToJsonArray(databaseIds));
+
+    if (!internalGenericPartialData(d->mSelectTracksFromIdsQuery)) {
+        return result;
+    }
+
+    auto tracksById = QHash<qulonglong, DataTypes::TrackDataType>{};
+    tracksById.reserve(databaseIds.size());
+    while (d->mSelectTracksFromIdsQuery.next()) {
+        auto oneTrack = buildTrackDataFromDatabaseRecord(d->mSelectTracksFromIdsQuery.record());
+        tracksById.insert(oneTrack.databaseId(), oneTrack);
+    }
+
+    d->mSelectTracksFromIdsQuery.finish();
+
+    result.reserve(databaseIds.size());
+    for (auto trackId : databaseIds) {
+        result.push_back(tracksById.value(trackId));
+    }
+
+    return result;
+}
+
 DataTypes::TrackDataType DatabaseInterface::internalOneTrackPartialDataByIdAndUrl(qulonglong databaseId, const QUrl &trackUrl)
 {
     auto result = DataTypes::TrackDataType{};
@@ -9704,6 +10576,144 @@ QVariantList DatabaseInterface::internalGetLatestFourCoversForArtist(const QStri
     return covers;
 }
 
+QHash<qulonglong, QVariantList> DatabaseInterface::internalGetLatestFourCoversForArtists(const QSet<qulonglong> &artistIds)
+{
+    auto result = QHash<qulonglong, QVariantList>{};
+
+    if (artistIds.isEmpty()) {
+        return result;
+    }
+
+    d->mSelectUpToFourLatestCoversFromArtistIdsQuery.bindValue(QStringLiteral(":artistIds"), databaseIdsToJsonArray(artistIds));
+
+    auto queryResult = execQuery(d->mSelectUpToFourLatestCoversFromArtistIdsQuery);
+
+    if (!queryResult || !d->mSelectUpToFourLatestCoversFromArtistIdsQuery.isSelect() || !d->mSelectUpToFourLatestCoversFromArtistIdsQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalGetLatestFourCoversForArtists"
+                                        << d->mSelectUpToFourLatestCoversFromArtistIdsQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalGetLatestFourCoversForArtists"
+                                        << d->mSelectUpToFourLatestCoversFromArtistIdsQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalGetLatestFourCoversForArtists"
+                                        << d->mSelectUpToFourLatestCoversFromArtistIdsQuery.lastError();
+
+        d->mSelectUpToFourLatestCoversFromArtistIdsQuery.finish();
+
+        return result;
+    }
+
+    while (d->mSelectUpToFourLatestCoversFromArtistIdsQuery.next()) {
+        const auto &currentRecord = d->mSelectUpToFourLatestCoversFromArtistIdsQuery.record();
+        const auto artistId = currentRecord.value(0).toULongLong();
+        const auto &cover = currentRecord.value(1).toUrl();
+        const auto isTrackCover = currentRecord.value(2).toBool();
+        if (isTrackCover) {
+            result[artistId].push_back(QVariant {QLatin1String {"image://cover/"} + cover.toLocalFile()}.toUrl());
+        } else {
+            result[artistId].push_back(cover);
+        }
+    }
+
+    d->mSelectUpToFourLatestCoversFromArtistIdsQuery.finish();
+
+    return result;
+}
+
+void DatabaseInterface::bufferPlayStatistics(const QUrl &fileName, const QDateTime &time, bool hasFinished)
+{
+    if (!d) {
+        return;
+    }
+
+    if (d->mPlayStatisticsJournal.isOpen() || d->mPlayStatisticsJournal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        d->mPlayStatisticsJournal.write((hasFinished ? "F " : "S ") + QByteArray::number(time.toMSecsSinceEpoch()) + ' ' + fileName.toEncoded() + '\n');
+        d->mPlayStatisticsJournal.flush();
+    }
+
+    d->mPendingPlayStatistics.push_back({fileName, time, hasFinished});
+
+    if (d->mPendingPlayStatistics.size() >= DatabaseInterfacePrivate::PlayStatisticsMaximumBatchSize) {
+        flushPlayStatistics();
+        return;
+    }
+
+    d->mPlayStatisticsTimer.start();
+}
+
+void DatabaseInterface::flushPlayStatistics()
+{
+    if (!d || d->mPendingPlayStatistics.isEmpty()) {
+        return;
+    }
+
+    d->mPlayStatisticsTimer.stop();
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    for (const auto &oneEvent : std::as_const(d->mPendingPlayStatistics)) {
+        if (oneEvent.mHasFinished) {
+            updateTrackFinishedStatistics(oneEvent.mFileName, oneEvent.mTime);
+        } else {
+            updateTrackStartedStatistics(oneEvent.mFileName, oneEvent.mTime);
+        }
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    d->mPendingPlayStatistics.clear();
+
+    // a crash before this point replays events already written: play counters may be counted twice
+    if (d->mPlayStatisticsJournal.isOpen()) {
+        d->mPlayStatisticsJournal.resize(0);
+        d->syncPlayStatisticsJournal();
+    }
+}
+
+void DatabaseInterface::replayPlayStatisticsJournal()
+{
+    if (!d->mPlayStatisticsJournal.open(QIODevice::ReadWrite | QIODevice::Append)) {
+        qCWarning(orgKdeElisaDatabase) << "DatabaseInterface::replayPlayStatisticsJournal" << d->mPlayStatisticsJournal.fileName()
+                                       << d->mPlayStatisticsJournal.errorString();
+        return;
+    }
+
+    d->mPlayStatisticsJournal.seek(0);
+    const auto journalContent = d->mPlayStatisticsJournal.readAll();
+    for (const auto &oneLine : journalContent.split('\n')) {
+        const auto fields = oneLine.split(' ');
+
+        // the last event may be incomplete if the application crashed while writing it
+        if (fields.size() != 3 || (fields[0] != "S" && fields[0] != "F")) {
+            continue;
+        }
+
+        auto isValidTime = false;
+        const auto time = fields[1].toLongLong(&isValidTime);
+        const auto fileName = QUrl::fromEncoded(fields[2]);
+        if (!isValidTime || !fileName.isValid()) {
+            continue;
+        }
+
+        d->mPendingPlayStatistics.push_back({fileName, QDateTime::fromMSecsSinceEpoch(time), fields[0] == "F"});
+    }
+
+    if (d->mPendingPlayStatistics.isEmpty()) {
+        d->mPlayStatisticsJournal.resize(0);
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::replayPlayStatisticsJournal" << d->mPendingPlayStatistics.size() << "play events not written before exit";
+
+    flushPlayStatistics();
+}
+
 void DatabaseInterface::updateTrackStartedStatistics(const QUrl &fileName, const QDateTime &time)
 {
     d->mUpdateTrackStartedStatistics.bindValue(QStringLiteral(":fileName"), fileName);
@@ -9767,50 +10777,63 @@ void DatabaseInterface::updateTrackFinishedStatistics(const QUrl &fileName, cons
     d->mUpdateTrackFirstPlayStatistics.finish();
 }
 
-bool DatabaseInterface::execHasRowQuery(QSqlQuery &query)
+void DatabaseInterface::pruneOrphans(QSqlQuery &selectOrphansQuery, QSqlQuery &removeQuery, const QString &idsParameter,
+                                     QSet<qulonglong> &possiblyRemovedIds, QSet<qulonglong> &removedIds)
 {
-    if (!execQuery(query) || !query.isActive()) {
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.lastError();
+    // Remove invalid ID
+    possiblyRemovedIds.remove(0);
+
+    if (possiblyRemovedIds.isEmpty()) {
+        return;
+    }
+
+    selectOrphansQuery.bindValue(idsParameter, databaseIdsToJsonArray(possiblyRemovedIds));
+    possiblyRemovedIds.clear();
+
+    auto queryResult = execQuery(selectOrphansQuery);
 
+    if (!queryResult || !selectOrphansQuery.isSelect() || !selectOrphansQuery.isActive()) {
         Q_EMIT databaseError();
 
-        query.finish();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << selectOrphansQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << selectOrphansQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << selectOrphansQuery.lastError();
 
-        return false;
+        selectOrphansQuery.finish();
+
+        return;
     }
 
-    bool result = false;
-    if (query.next()) {
-        result = query.value(0).toBool();
+    auto orphanIds = QSet<qulonglong>{};
+    while (selectOrphansQuery.next()) {
+        orphanIds.insert(selectOrphansQuery.record().value(0).toULongLong());
     }
-    query.finish();
-    return result;
-}
 
-bool DatabaseInterface::artistHasTracks(qulonglong artistId)
-{
-    d->mArtistHasTracksQuery.bindValue(u":artistId"_s, artistId);
-    return execHasRowQuery(d->mArtistHasTracksQuery);
-}
+    selectOrphansQuery.finish();
 
-bool DatabaseInterface::genreHasTracks(qulonglong genreId)
-{
-    d->mGenreHasTracksQuery.bindValue(u":genreId"_s, genreId);
-    return execHasRowQuery(d->mGenreHasTracksQuery);
-}
+    if (orphanIds.isEmpty()) {
+        return;
+    }
 
-bool DatabaseInterface::composerHasTracks(qulonglong composerId)
-{
-    d->mComposerHasTracksQuery.bindValue(u":composerId"_s, composerId);
-    return execHasRowQuery(d->mComposerHasTracksQuery);
-}
+    removeQuery.bindValue(idsParameter, databaseIdsToJsonArray(orphanIds));
 
-bool DatabaseInterface::lyricistHasTracks(qulonglong lyricistId)
-{
-    d->mLyricistHasTracksQuery.bindValue(u":lyricistId"_s, lyricistId);
-    return execHasRowQuery(d->mLyricistHasTracksQuery);
+    queryResult = execQuery(removeQuery);
+
+    if (!queryResult || !removeQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << removeQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << removeQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::pruneOrphans" << removeQuery.lastError();
+
+        removeQuery.finish();
+
+        return;
+    }
+
+    removeQuery.finish();
+
+    removedIds.unite(orphanIds);
 }
 
 void DatabaseInterface::pruneCollections()
@@ -9823,58 +10846,26 @@ void DatabaseInterface::pruneCollections()
 
 void DatabaseInterface::pruneArtists()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedArtistIds.remove(0);
-
-    for (const auto artistId : std::as_const(d->mPossiblyRemovedArtistIds)) {
-        if (!artistHasTracks(artistId)) {
-            removeArtistInDatabase(artistId);
-            d->mRemovedArtistIds.insert(artistId);
-        }
-    }
-    d->mPossiblyRemovedArtistIds.clear();
+    pruneOrphans(d->mSelectOrphanArtistsQuery, d->mRemoveArtistQuery, u":artistIds"_s,
+                 d->mPossiblyRemovedArtistIds, d->mRemovedArtistIds);
 }
 
 void DatabaseInterface::pruneGenres()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedGenreIds.remove(0);
-
-    for (const auto genreId : std::as_const(d->mPossiblyRemovedGenreIds)) {
-        if (!genreHasTracks(genreId)) {
-            removeGenreInDatabase(genreId);
-            d->mRemovedGenreIds.insert(genreId);
-        }
-    }
-    d->mPossiblyRemovedGenreIds.clear();
+    pruneOrphans(d->mSelectOrphanGenresQuery, d->mRemoveGenreQuery, u":genreIds"_s,
+                 d->mPossiblyRemovedGenreIds, d->mRemovedGenreIds);
 }
 
 void DatabaseInterface::pruneComposers()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedComposerIds.remove(0);
-
-    for (const auto composerId : std::as_const(d->mPossiblyRemovedComposerIds)) {
-        if (!composerHasTracks(composerId)) {
-            removeComposerInDatabase(composerId);
-            d->mRemovedComposerIds.insert(composerId);
-        }
-    }
-    d->mPossiblyRemovedComposerIds.clear();
+    pruneOrphans(d->mSelectOrphanComposersQuery, d->mRemoveComposerQuery, u":composerIds"_s,
+                 d->mPossiblyRemovedComposerIds, d->mRemovedComposerIds);
 }
 
 void DatabaseInterface::pruneLyricists()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedLyricistsIds.remove(0);
-
-    for (const auto lyricistId : std::as_const(d->mPossiblyRemovedLyricistsIds)) {
-        if (!lyricistHasTracks(lyricistId)) {
-            removeLyricistInDatabase(lyricistId);
-            d->mRemovedLyricistIds.insert(lyricistId);
-        }
-    }
-    d->mPossiblyRemovedLyricistsIds.clear();
+    pruneOrphans(d->mSelectOrphanLyricistsQuery, d->mRemoveLyricistQuery, u":lyricistIds"_s,
+                 d->mPossiblyRemovedLyricistsIds, d->mRemovedLyricistIds);
 }
 
 #include "moc_databaseinterface.cpp"
@@ -16,6 +16,7 @@
 #include <QQmlEngine>
 #include <QString>
 #include <QHash>
+#include <QSet>
 #include <QList>
 #include <QUrl>
 #include <QDateTime>
@@ -46,6 +47,7 @@ public:
         V15 = 15,
         V16 = 16,
         V17 = 17,
+        V18 = 18,
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
@@ -54,6 +56,12 @@ public:
 
     Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
 
+    /**
+     * Open an existing database as a read-only connection used for view queries.
+     * It never modifies the schema and can run concurrently with the writer thanks to WAL.
+     */
+    Q_INVOKABLE void initReadOnly(const QString &dbName, const QString &databaseFileName);
+
     qulonglong albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
 
     DataTypes::ListTrackDataType allTracksData();
@@ -96,14 +104,49 @@ public:
 
     DataTypes::TrackDataType trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl);
 
+    /**
+     * data of all known tracks in ids, in a single query
+     */
+    DataTypes::ListTrackDataType tracksDataFromDatabaseIds(const QList<qulonglong> &ids);
+
     DataTypes::TrackDataType radioDataFromDatabaseId(qulonglong id);
 
     qulonglong trackIdFromTitleAlbumTrackDiscNumber(const QString &title, const QString &artist, const std::optional<QString> &album, std::optional<int> trackNumber, std::optional<int> discNumber);
 
     qulonglong trackIdFromFileName(const QUrl &fileName);
 
+    /**
+     * ids of all known tracks in fileNames, in a single query
+     */
+    QHash<QUrl, qulonglong> trackIdsFromFileNames(const QList<QUrl> &fileNames);
+
     qulonglong radioIdFromFileName(const QUrl &fileName);
 
+    /**
+     * true if tracks or albums can be searched in the full text index of tracks
+     */
+    [[nodiscard]] bool canSearchData(ElisaUtils::PlayListEntryType dataType) const;
+
+    /**
+     * false if searchText has no word that can be found in the full text index, like punctuation only
+     */
+    [[nodiscard]] static bool isSearchableText(const QString &searchText);
+
+    /**
+     * number of queries executed by this instance, to check that batches use a bounded number of queries
+     */
+    [[nodiscard]] qulonglong executedQueriesCount() const;
+
+    /**
+     * number of queries the last insertTracksList executed to read back the added and modified data
+     */
+    [[nodiscard]] qulonglong insertedDataFetchQueriesCount() const;
+
+    /**
+     * ids of the tracks or albums whose title, artists or album contain words starting with each word of searchText
+     */
+    QList<qulonglong> databaseIdsMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
     void applicationAboutToQuit();
 
 Q_SIGNALS:
@@ -152,6 +195,11 @@ public Q_SLOTS:
 
     void trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time);
 
+    /**
+     * write the buffered play events, only the instance receiving them has some
+     */
+    void flushPlayStatistics();
+
     void clearData();
 
     void removeRadio(qulonglong radioId);
@@ -165,7 +213,7 @@ private:
 
     /********* Init and upgrade methods *********/
 
-    void initConnection(const QString &connectionName, const QString &databaseFileName);
+    void initConnection(const QString &connectionName, const QString &databaseFileName, bool readOnly = false);
 
     bool initDatabase();
 
@@ -187,6 +235,10 @@ private:
 
     void upgradeDatabaseV17();
 
+    void upgradeDatabaseV18();
+
+    void createTracksSearchIndex();
+
     [[nodiscard]] DatabaseState checkDatabaseSchema() const;
 
     [[nodiscard]] DatabaseState checkTable(const QString &tableName, const QStringList &expectedColumns) const;
@@ -244,6 +296,10 @@ private:
 
     qulonglong internalTrackIdFromFileName(const QUrl &fileName);
 
+    QHash<QUrl, qulonglong> internalTrackIdsFromFileNames(const QList<QUrl> &fileNames);
+
+    QList<qulonglong> internalDatabaseIdsMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
     qulonglong internalRadioIdFromHttpAddress(const QString &httpAddress);
 
     DataTypes::ListTrackDataType internalTracksFromAuthor(const QString &artistName);
@@ -278,10 +334,6 @@ private:
 
     void removeTrackInDatabase(qulonglong trackId);
     void removeAlbumInDatabase(qulonglong albumId);
-    void removeArtistInDatabase(qulonglong artistId);
-    void removeGenreInDatabase(qulonglong genreId);
-    void removeComposerInDatabase(qulonglong composerId);
-    void removeLyricistInDatabase(qulonglong lyricistId);
 
     void reloadExistingDatabase();
 
@@ -297,8 +349,20 @@ private:
 
     [[nodiscard]] DataTypes::TrackDataType buildRadioDataFromDatabaseRecord(const QSqlRecord &trackRecord) const;
 
+    [[nodiscard]] DataTypes::AlbumDataType buildAlbumDataFromDatabaseRecord(const QSqlRecord &albumRecord) const;
+
     void internalRemoveTracksList(const QList<QUrl> &removedTracks);
 
+    /**
+     * Remove a large list of files with a few statements and return the ids of the albums they belonged to
+     */
+    QSet<qulonglong> internalBulkRemoveTracksList(const QList<QUrl> &removedTracks);
+
+    /**
+     * Remove the albums of albumIds left without any track and return their ids
+     */
+    QSet<qulonglong> internalBulkRemoveEmptyAlbums(const QSet<qulonglong> &albumIds);
+
     void internalRemoveTracksList(const QHash<QUrl, QDateTime> &removedTracks, qulonglong sourceId);
 
     QUrl internalAlbumArtUriFromAlbumId(qulonglong albumId);
@@ -316,7 +380,9 @@ private:
     DataTypes::ListTrackDataType internalOneAlbumData(qulonglong databaseId);
 
     DataTypes::AlbumDataType internalOneAlbumPartialData(qulonglong databaseId);
+    DataTypes::ListAlbumDataType internalAlbumsPartialData(const QSet<qulonglong> &databaseIds);
     DataTypes::ArtistDataType internalOneArtistPartialData(qulonglong databaseId);
+    DataTypes::ListArtistDataType internalArtistsPartialData(const QSet<qulonglong> &databaseIds);
     DataTypes::GenreDataType internalOneGenrePartialData(qulonglong databaseId);
     DataTypes::ArtistDataType internalOneLyricistPartialData(qulonglong databaseId);
     DataTypes::ArtistDataType internalOneComposerPartialData(qulonglong databaseId);
@@ -331,6 +397,8 @@ private:
 
     DataTypes::TrackDataType internalOneTrackPartialData(qulonglong databaseId);
 
+    DataTypes::ListTrackDataType internalTracksPartialData(const QSet<qulonglong> &databaseIds);
+
     DataTypes::TrackDataType internalOneTrackPartialDataByIdAndUrl(qulonglong databaseId, const QUrl &trackUrl);
 
     DataTypes::TrackDataType internalOneRadioPartialData(qulonglong databaseId);
@@ -348,6 +416,12 @@ private:
 
     QVariantList internalGetLatestFourCoversForArtist(const QString& artistName);
 
+    QHash<qulonglong, QVariantList> internalGetLatestFourCoversForArtists(const QSet<qulonglong> &artistIds);
+
+    void bufferPlayStatistics(const QUrl &fileName, const QDateTime &time, bool hasFinished);
+
+    void replayPlayStatisticsJournal();
+
     void updateTrackStartedStatistics(const QUrl &fileName, const QDateTime &time);
 
     void updateTrackFinishedStatistics(const QUrl &fileName, const QDateTime &time);
@@ -357,14 +431,10 @@ private:
     void internalInsertOneRadio(const DataTypes::TrackDataType &oneTrack);
 
     /**
-     * Execute a query that checks whether there is at least 1 matching row
+     * Remove the ids among possiblyRemovedIds that are no longer referenced by any track and add them to removedIds
      */
-    bool execHasRowQuery(QSqlQuery &query);
-
-    bool artistHasTracks(qulonglong artistId);
-    bool genreHasTracks(qulonglong genreId);
-    bool composerHasTracks(qulonglong composerId);
-    bool lyricistHasTracks(qulonglong lyricistId);
+    void pruneOrphans(QSqlQuery &selectOrphansQuery, QSqlQuery &removeQuery, const QString &idsParameter,
+                      QSet<qulonglong> &possiblyRemovedIds, QSet<qulonglong> &removedIds);
 
     void pruneCollections();
     void pruneArtists();
@@ -7,12 +7,33 @@
 
 #include "datatypes.h"
 
+#include "elisautils.h"
+
+#include <QDebug>
+
+#include <array>
+
 bool DataTypes::TrackDataType::albumInfoIsSame(const TrackDataType &other) const
 {
     return hasAlbum() == other.hasAlbum() && album() == other.album() &&
            hasAlbumArtist() == other.hasAlbumArtist() && albumArtist() == other.albumArtist();
 }
 
+void DataTypes::TrackDataType::internMetaDataStrings()
+{
+    static constexpr std::array internedRoles = {
+        key_type::ArtistRole, key_type::AlbumRole, key_type::AlbumArtistRole,
+        key_type::GenreRole, key_type::ComposerRole, key_type::LyricistRole,
+    };
+
+    for (const auto role : internedRoles) {
+        auto itValue = find(role);
+        if (itValue != end() && itValue->typeId() == QMetaType::QString) {
+            *itValue = ElisaUtils::internString(itValue->toString());
+        }
+    }
+}
+
 bool DataTypes::TrackDataType::isSameTrack(const TrackDataType& other) const
 {
     return title() == other.title() &&
@@ -34,5 +55,15 @@ bool DataTypes::TrackDataType::isSameTrack(const TrackDataType& other) const
            hasSampleRate() == other.hasSampleRate() && (hasSampleRate() ? sampleRate() == other.sampleRate() : true);
 }
 
+QDebug operator<<(QDebug stream, const DataTypes::DataType &data)
+{
+    QDebugStateSaver saver(stream);
+    stream.nospace() << "DataType(";
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        stream << '(' << it.key() << ", " << it.value() << ')';
+    }
+    stream << ')';
+    return stream;
+}
 
 #include "moc_datatypes.cpp"
@@ -20,6 +20,13 @@
 #include <QUrl>
 #include <QDateTime>
 #include <QMap>
+#include <QtAlgorithms>
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+class QDebug;
 
 class ELISALIB_EXPORT DataTypes : public QObject
 {
@@ -82,7 +89,434 @@ public:
 
     Q_ENUM(ColumnsRoles)
 
-    using DataType = QMap<ColumnsRoles, QVariant>;
+    /**
+     * Compact record mapping roles to their value
+     *
+     * It provides the subset of the QMap<ColumnsRoles, QVariant> API used by Elisa. The roles of
+     * ColumnsRoles are tracked by a bit mask and their values are stored contiguously in role order
+     * in one implicitly shared array: a lookup is a population count and a record costs a single
+     * allocation instead of one tree node per role. Roles outside of ColumnsRoles are kept at the
+     * end of the array.
+     */
+    class DataType
+    {
+    public:
+
+        using key_type = ColumnsRoles;
+
+        using mapped_type = QVariant;
+
+        using size_type = qsizetype;
+
+        class iterator
+        {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+
+            using difference_type = qptrdiff;
+
+            using value_type = QVariant;
+
+            using pointer = QVariant *;
+
+            using reference = QVariant &;
+
+            iterator() = default;
+
+            [[nodiscard]] key_type key() const
+            {
+                return mData->keyAt(mPosition);
+            }
+
+            [[nodiscard]] QVariant &value() const
+            {
+                return mData->mValues[mPosition];
+            }
+
+            QVariant &operator*() const
+            {
+                return value();
+            }
+
+            QVariant *operator->() const
+            {
+                return &value();
+            }
+
+            iterator &operator++()
+            {
+                ++mPosition;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto result = *this;
+                ++mPosition;
+                return result;
+            }
+
+            friend bool operator==(const iterator &lhs, const iterator &rhs)
+            {
+                return lhs.mData == rhs.mData && lhs.mPosition == rhs.mPosition;
+            }
+
+            friend bool operator!=(const iterator &lhs, const iterator &rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+
+            friend class DataType;
+
+            friend class const_iterator;
+
+            iterator(DataType *data, qsizetype position) : mData(data), mPosition(position)
+            {
+            }
+
+            DataType *mData = nullptr;
+
+            qsizetype mPosition = 0;
+        };
+
+        class const_iterator
+        {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+
+            using difference_type = qptrdiff;
+
+            using value_type = QVariant;
+
+            using pointer = const QVariant *;
+
+            using reference = const QVariant &;
+
+            const_iterator() = default;
+
+            const_iterator(const iterator &other) : mData(other.mData), mPosition(other.mPosition)
+            {
+            }
+
+            [[nodiscard]] key_type key() const
+            {
+                return mData->keyAt(mPosition);
+            }
+
+            [[nodiscard]] const QVariant &value() const
+            {
+                return mData->mValues.at(mPosition);
+            }
+
+            const QVariant &operator*() const
+            {
+                return value();
+            }
+
+            const QVariant *operator->() const
+            {
+                return &value();
+            }
+
+            const_iterator &operator++()
+            {
+                ++mPosition;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto result = *this;
+                ++mPosition;
+                return result;
+            }
+
+            friend bool operator==(const const_iterator &lhs, const const_iterator &rhs)
+            {
+                return lhs.mData == rhs.mData && lhs.mPosition == rhs.mPosition;
+            }
+
+            friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+
+            friend class DataType;
+
+            const_iterator(const DataType *data, qsizetype position) : mData(data), mPosition(position)
+            {
+            }
+
+            const DataType *mData = nullptr;
+
+            qsizetype mPosition = 0;
+        };
+
+        using key_value_iterator = QKeyValueIterator<key_type, QVariant &, iterator>;
+
+        using const_key_value_iterator = QKeyValueIterator<key_type, const QVariant &, const_iterator>;
+
+        DataType() = default;
+
+        DataType(std::initializer_list<std::pair<key_type, QVariant>> list)
+        {
+            for (const auto &oneValue : list) {
+                insert(oneValue.first, oneValue.second);
+            }
+        }
+
+        [[nodiscard]] bool isEmpty() const
+        {
+            return mValues.isEmpty();
+        }
+
+        [[nodiscard]] size_type size() const
+        {
+            return mValues.size();
+        }
+
+        [[nodiscard]] size_type count() const
+        {
+            return mValues.size();
+        }
+
+        void clear()
+        {
+            mRoles = 0;
+            mOverflowRoles.clear();
+            mValues.clear();
+        }
+
+        [[nodiscard]] bool contains(key_type key) const
+        {
+            return position(key) >= 0;
+        }
+
+        [[nodiscard]] QVariant value(key_type key, const QVariant &defaultValue = {}) const
+        {
+            const auto valuePosition = position(key);
+            return valuePosition >= 0 ? mValues.at(valuePosition) : defaultValue;
+        }
+
+        QVariant operator[](key_type key) const
+        {
+            return value(key);
+        }
+
+        QVariant &operator[](key_type key)
+        {
+            auto valuePosition = position(key);
+            if (valuePosition < 0) {
+                valuePosition = insertNewRole(key, {});
+            }
+            return mValues[valuePosition];
+        }
+
+        iterator insert(key_type key, const QVariant &value)
+        {
+            auto valuePosition = position(key);
+            if (valuePosition < 0) {
+                valuePosition = insertNewRole(key, value);
+            } else {
+                mValues[valuePosition] = value;
+            }
+            return {this, valuePosition};
+        }
+
+        size_type remove(key_type key)
+        {
+            const auto valuePosition = position(key);
+            if (valuePosition < 0) {
+                return 0;
+            }
+
+            if (isCompactRole(key)) {
+                mRoles &= ~roleBit(key);
+            } else {
+                mOverflowRoles.removeAt(valuePosition - compactCount());
+            }
+            mValues.removeAt(valuePosition);
+
+            return 1;
+        }
+
+        QVariant take(key_type key)
+        {
+            auto result = value(key);
+            remove(key);
+            return result;
+        }
+
+        [[nodiscard]] QList<key_type> keys() const
+        {
+            auto result = QList<key_type>{};
+            result.reserve(size());
+            for (auto it = constBegin(); it != constEnd(); ++it) {
+                result.push_back(it.key());
+            }
+            return result;
+        }
+
+        iterator find(key_type key)
+        {
+            const auto valuePosition = position(key);
+            return {this, valuePosition >= 0 ? valuePosition : size()};
+        }
+
+        const_iterator find(key_type key) const
+        {
+            return constFind(key);
+        }
+
+        const_iterator constFind(key_type key) const
+        {
+            const auto valuePosition = position(key);
+            return {this, valuePosition >= 0 ? valuePosition : size()};
+        }
+
+        iterator begin()
+        {
+            return {this, 0};
+        }
+
+        iterator end()
+        {
+            return {this, size()};
+        }
+
+        const_iterator begin() const
+        {
+            return constBegin();
+        }
+
+        const_iterator end() const
+        {
+            return constEnd();
+        }
+
+        const_iterator cbegin() const
+        {
+            return constBegin();
+        }
+
+        const_iterator cend() const
+        {
+            return constEnd();
+        }
+
+        const_iterator constBegin() const
+        {
+            return {this, 0};
+        }
+
+        const_iterator constEnd() const
+        {
+            return {this, size()};
+        }
+
+        key_value_iterator keyValueBegin()
+        {
+            return key_value_iterator{begin()};
+        }
+
+        key_value_iterator keyValueEnd()
+        {
+            return key_value_iterator{end()};
+        }
+
+        const_key_value_iterator constKeyValueBegin() const
+        {
+            return const_key_value_iterator{constBegin()};
+        }
+
+        const_key_value_iterator constKeyValueEnd() const
+        {
+            return const_key_value_iterator{constEnd()};
+        }
+
+        friend bool operator==(const DataType &lhs, const DataType &rhs)
+        {
+            return lhs.mRoles == rhs.mRoles && lhs.mOverflowRoles == rhs.mOverflowRoles && lhs.mValues == rhs.mValues;
+        }
+
+        friend bool operator!=(const DataType &lhs, const DataType &rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+
+        static constexpr int CompactRolesCount = TracksCountRole - TitleRole + 1;
+
+        static_assert(CompactRolesCount <= 64, "compact roles must fit in the roles bit mask");
+
+        static constexpr bool isCompactRole(key_type key)
+        {
+            return key >= TitleRole && key <= TracksCountRole;
+        }
+
+        static constexpr quint64 roleBit(key_type key)
+        {
+            return quint64{1} << (key - TitleRole);
+        }
+
+        [[nodiscard]] qsizetype compactCount() const
+        {
+            return qPopulationCount(mRoles);
+        }
+
+        [[nodiscard]] qsizetype position(key_type key) const
+        {
+            if (isCompactRole(key)) {
+                const auto bit = roleBit(key);
+                return (mRoles & bit) ? qsizetype{qPopulationCount(mRoles & (bit - 1))} : -1;
+            }
+
+            const auto overflowIndex = mOverflowRoles.indexOf(key);
+            return overflowIndex >= 0 ? compactCount() + overflowIndex : -1;
+        }
+
+        [[nodiscard]] key_type keyAt(qsizetype valuePosition) const
+        {
+            const auto compactRolesCount = compactCount();
+            if (valuePosition >= compactRolesCount) {
+                return mOverflowRoles.at(valuePosition - compactRolesCount);
+            }
+
+            auto remainingRoles = mRoles;
+            for (qsizetype i = 0; i < valuePosition; ++i) {
+                remainingRoles &= remainingRoles - 1;
+            }
+            return static_cast<key_type>(TitleRole + qCountTrailingZeroBits(remainingRoles));
+        }
+
+        qsizetype insertNewRole(key_type key, const QVariant &value)
+        {
+            auto valuePosition = qsizetype{0};
+            if (isCompactRole(key)) {
+                const auto bit = roleBit(key);
+                valuePosition = qPopulationCount(mRoles & (bit - 1));
+                mRoles |= bit;
+            } else {
+                valuePosition = mValues.size();
+                mOverflowRoles.push_back(key);
+            }
+            mValues.insert(valuePosition, value);
+            return valuePosition;
+        }
+
+        quint64 mRoles = 0;
+
+        QList<key_type> mOverflowRoles;
+
+        QList<QVariant> mValues;
+    };
 
 public:
 
@@ -329,6 +763,12 @@ public:
 
         [[nodiscard]] bool albumInfoIsSame(const TrackDataType &other) const;
 
+        /**
+         * Replace artist, album, genre, composer and lyricist names by their interned copy
+         * (see ElisaUtils::internString) so that identical names share one buffer.
+         */
+        void internMetaDataStrings();
+
         [[nodiscard]] bool isSameTrack(const TrackDataType &other) const;
     };
 
@@ -435,6 +875,9 @@ public:
 
 };
 
+ELISALIB_EXPORT QDebug operator<<(QDebug stream, const DataTypes::DataType &data);
+
+Q_DECLARE_METATYPE(DataTypes::DataType)
 Q_DECLARE_METATYPE(DataTypes::MusicDataType)
 Q_DECLARE_METATYPE(DataTypes::TrackDataType)
 Q_DECLARE_METATYPE(DataTypes::AlbumDataType)
@@ -6,6 +6,9 @@
 
 #include "elisautils.h"
 
+#include <QReadWriteLock>
+#include <QSet>
+
 namespace ElisaUtils
 {
 
@@ -18,6 +21,27 @@ bool isPlayList(const QMimeType& mimeType)
         || mimeType.inherits(QStringLiteral("audio/vnd.rn-realaudio")) || mimeType.inherits(QStringLiteral("audio/x-pn-realaudio"));
 }
 
+QString internString(const QString &value)
+{
+    if (value.isEmpty()) {
+        return value;
+    }
+
+    static QReadWriteLock internedStringsLock;
+    static QSet<QString> internedStrings;
+
+    {
+        QReadLocker internedStringsLocker(&internedStringsLock);
+        const auto itString = internedStrings.constFind(value);
+        if (itString != internedStrings.constEnd()) {
+            return *itString;
+        }
+    }
+
+    QWriteLocker internedStringsLocker(&internedStringsLock);
+    return *internedStrings.insert(value);
+}
+
 }
 
 #include "moc_elisautils.cpp"
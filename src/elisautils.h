@@ -77,6 +77,13 @@ Q_ENUM_NS(FilterType)
 
 bool isPlayList(const QMimeType& mimeType);
 
+/**
+ * Return a copy of value sharing its buffer with every other interned string with the same content.
+ * Interned strings are kept for the lifetime of the application: only use it for metadata like
+ * artist, album or genre names that are repeated over many tracks. It is thread-safe.
+ */
+QString internString(const QString &value);
+
 }
 
 #endif // ELISAUTILS_H
@@ -6,6 +6,10 @@
 
 #include "embeddedcoverageimageprovider.h"
 
+#include "coverstore.h"
+#include "coverthumbnailcache.h"
+#include "viewsLogging.h"
+
 #include <KFileMetaData/EmbeddedImageData>
 #include <KFileMetaData/ExtractorCollection>
 #include <KFileMetaData/SimpleExtractionResult>
@@ -20,8 +24,8 @@ class AsyncImageResponse : public QQuickImageResponse, public QRunnable
     Q_OBJECT
 
 public:
-    AsyncImageResponse(QString id, QSize requestedSize)
-        : QQuickImageResponse(), mId(std::move(id)), mRequestedSize(requestedSize)
+    AsyncImageResponse(QString id, QSize requestedSize, CoverThumbnailCache *cache, const CoverStore *coverStore)
+        : QQuickImageResponse(), mId(std::move(id)), mRequestedSize(requestedSize), mCache(cache), mCoverStore(coverStore)
     {
         setAutoDelete(false);
 
@@ -41,13 +45,28 @@ public:
 
     void run() override
     {
+        mErrorMessage = QLatin1String{""};
+
+        const auto cacheKey = CoverThumbnailCache::cacheKey(mId, mRequestedSize);
+        mCoverImage = mCache->image(cacheKey);
+        if (!mCoverImage.isNull()) {
+            Q_EMIT finished();
+            return;
+        }
+
+        // the thumbnails of the cover store are already on disk: they are only kept in memory by the cache
+        mCoverImage = mCoverStore->cover(mId, mRequestedSize);
+        if (!mCoverImage.isNull()) {
+            scaleAndCacheCoverImage(cacheKey, CoverThumbnailCache::MemoryOnly);
+            Q_EMIT finished();
+            return;
+        }
+
         QMimeDatabase mimeDatabase;
         const auto fileMimeType = mimeDatabase.mimeTypeForFile(mId).name();
         KFileMetaData::ExtractorCollection ec;
         KFileMetaData::SimpleExtractionResult result(mId, fileMimeType, KFileMetaData::ExtractionResult::ExtractImageData);
 
-        mErrorMessage = QLatin1String{""};
-
         const auto extractors = ec.fetchExtractors(fileMimeType);
         for (const auto& ex : extractors) {
             ex->extract(&result);
@@ -61,11 +80,8 @@ public:
           return;
         }
 
-        if (imageData.contains(KFileMetaData::EmbeddedImageData::FrontCover)) {
-          mCoverImage = QImage::fromData(imageData[KFileMetaData::EmbeddedImageData::FrontCover]);
-        } else {
-          mCoverImage = QImage::fromData(imageData.first());
-        }
+        const auto &coverData = imageData.value(KFileMetaData::EmbeddedImageData::FrontCover, imageData.first());
+        mCoverImage = QImage::fromData(coverData);
 
         if (mCoverImage.isNull()) {
           mErrorMessage = QString{QLatin1String{"Invalid embedded cover image in "} + mId};
@@ -73,12 +89,21 @@ public:
           return;
         }
 
+        const auto isInCoverStore = !mCoverStore->storeCover(mId, coverData).isEmpty() && CoverStore::hasThumbnailFor(mRequestedSize);
+
+        scaleAndCacheCoverImage(cacheKey, isInCoverStore ? CoverThumbnailCache::MemoryOnly : CoverThumbnailCache::MemoryAndDisk);
+
+        Q_EMIT finished();
+    }
+
+    void scaleAndCacheCoverImage(const QString &cacheKey, CoverThumbnailCache::Storage storage)
+    {
         auto newCoverImage = mCoverImage.scaled(mRequestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
         if (!newCoverImage.isNull()) {
           mCoverImage = std::move(newCoverImage);
         }
 
-        Q_EMIT finished();
+        mCache->insert(cacheKey, mCoverImage, storage);
     }
 
     QString errorString() const override
@@ -90,19 +115,52 @@ public:
     QString mErrorMessage;
     QSize mRequestedSize;
     QImage mCoverImage;
+    CoverThumbnailCache *mCache = nullptr;
+    const CoverStore *mCoverStore = nullptr;
 };
 }
 
 EmbeddedCoverageImageProvider::EmbeddedCoverageImageProvider()
-    : QQuickAsyncImageProvider()
+    : QQuickAsyncImageProvider(), mCache(std::make_unique<CoverThumbnailCache>()), mCoverStore(std::make_unique<CoverStore>())
+{
+    pool.start([cache = mCache.get()]() {
+        cache->prune();
+    });
+}
+
+EmbeddedCoverageImageProvider::~EmbeddedCoverageImageProvider()
 {
+    pool.waitForDone();
+
+    qCDebug(orgKdeElisaViews()) << "EmbeddedCoverageImageProvider::~EmbeddedCoverageImageProvider"
+                                << "cache hits" << cacheHits() << "cache misses" << cacheMisses() << "hit ratio" << cacheHitRatio();
 }
 
 QQuickImageResponse *EmbeddedCoverageImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
 {
-    auto response = std::make_unique<AsyncImageResponse>(id, requestedSize);
+    auto response = std::make_unique<AsyncImageResponse>(id, requestedSize, mCache.get(), mCoverStore.get());
     pool.start(response.get());
     return response.release();
 }
 
+quint64 EmbeddedCoverageImageProvider::cacheHits() const
+{
+    return mCache->hits();
+}
+
+quint64 EmbeddedCoverageImageProvider::cacheMisses() const
+{
+    return mCache->misses();
+}
+
+double EmbeddedCoverageImageProvider::cacheHitRatio() const
+{
+    const auto requestsCount = cacheHits() + cacheMisses();
+    if (!requestsCount) {
+        return 0.;
+    }
+
+    return static_cast<double>(cacheHits()) / static_cast<double>(requestsCount);
+}
+
 #include "embeddedcoverageimageprovider.moc"
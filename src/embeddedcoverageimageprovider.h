@@ -12,16 +12,42 @@
 #include <QQuickAsyncImageProvider>
 #include <QThreadPool>
 
+#include <memory>
+
+class CoverStore;
+class CoverThumbnailCache;
+
 class ELISALIB_EXPORT EmbeddedCoverageImageProvider : public QQuickAsyncImageProvider
 {
 public:
 
     EmbeddedCoverageImageProvider();
 
+    ~EmbeddedCoverageImageProvider() override;
+
     QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
 
+    /**
+     * number of requests served from the in-memory or on-disk thumbnail cache
+     */
+    [[nodiscard]] quint64 cacheHits() const;
+
+    /**
+     * number of requests that needed to extract the cover from the audio file
+     */
+    [[nodiscard]] quint64 cacheMisses() const;
+
+    /**
+     * ratio of requests served from the thumbnail cache, between 0 and 1
+     */
+    [[nodiscard]] double cacheHitRatio() const;
+
 private:
 
+    std::unique_ptr<CoverThumbnailCache> mCache;
+
+    std::unique_ptr<CoverStore> mCoverStore;
+
     QThreadPool pool;
 
 };
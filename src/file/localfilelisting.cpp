@@ -60,6 +60,8 @@ void LocalFileListing::triggerRefreshOfContent()
         scanDirectoryTree(onePath);
     }
 
+    saveScanManifest();
+
     setWaitEndTrackRemoval(false);
 
     if (!waitEndTrackRemoval()) {
@@ -9,6 +9,8 @@
 #include "config-upnp-qt.h"
 
 #include "abstractfile/indexercommon.h"
+#include "coverfilecache.h"
+#include "coverstore.h"
 
 #if KFFileMetaData_FOUND
 
@@ -26,17 +28,6 @@
 #include <QHash>
 #include <QMimeDatabase>
 
-QStringList buildCoverFileNames(const QStringList &fileNames, const QStringList &fileExtensions)
-{
-    QStringList covers {};
-    for (const auto &fileName : fileNames) {
-        for (const auto &fileExtension : fileExtensions) {
-            covers.push_back(fileName + fileExtension);
-        }
-    }
-    return covers;
-}
-
 class FileScannerPrivate
 {
 public:
@@ -45,11 +36,26 @@ public:
 
     KFileMetaData::PropertyMultiMap mAllProperties;
 
+    QMap<KFileMetaData::EmbeddedImageData::ImageType, QByteArray> mAllImages;
+
     KFileMetaData::EmbeddedImageData mImageScanner;
 #endif
 
     QMimeDatabase mMimeDb;
 
+    /**
+     * the file whose type was last detected: the type is detected again if this file changed since
+     */
+    QString mLastMimeTypeFileName;
+
+    QDateTime mLastMimeTypeFileModificationTime;
+
+    qint64 mLastMimeTypeFileSize = -1;
+
+    QMimeType mLastMimeType;
+
+    const CoverStore *mCoverStore = nullptr;
+
 #if KFFileMetaData_FOUND
     const QHash<KFileMetaData::Property::Property, DataTypes::ColumnsRoles> propertyTranslation = {
         {KFileMetaData::Property::Artist, DataTypes::ColumnsRoles::ArtistRole},
@@ -72,30 +78,9 @@ public:
     };
 #endif
 
-    const QStringList constCoverExtensions {
-        QStringLiteral(".jpg")
-        ,QStringLiteral(".jpeg")
-        ,QStringLiteral(".png")
-        ,QStringLiteral(".webp")
-    };
-
-    const QStringList constCoverNames {
-        QStringLiteral("[Cc]over")
-        ,QStringLiteral("[Cc]over[Ii]mage")
-        ,QStringLiteral("[Ff]older")
-        ,QStringLiteral("[Aa]lbumart")
-    };
-
-    const QStringList constCoverGlobs = {
-        QStringLiteral("*[Cc]over*")
-        ,QStringLiteral("*[Ff]older*")
-        ,QStringLiteral("*[Ff]ront*")
-        ,QStringLiteral("*[Aa]lbumart*")
-    };
+    CoverFileCache mOwnCoverFileCache;
 
-    const QStringList coverFileAllImages = buildCoverFileNames({QStringLiteral("*")}, constCoverExtensions);
-    const QStringList coverFileNames = buildCoverFileNames(constCoverNames, constCoverExtensions);
-    const QStringList coverFileGlobs = buildCoverFileNames(constCoverGlobs, constCoverExtensions);
+    CoverFileCache *mCoverFileCache = &mOwnCoverFileCache;
 };
 
 FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
@@ -104,10 +89,28 @@ FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
 
 bool FileScanner::shouldScanFile(const QString &scanFile)
 {
-    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(scanFile);
+    const auto &fileMimeType = mimeTypeForFile(QFileInfo{scanFile});
     return fileMimeType.name().startsWith(QLatin1String("audio/"));
 }
 
+const QMimeType &FileScanner::mimeTypeForFile(const QFileInfo &fileInfo)
+{
+    // callers usually check a file with shouldScanFile before scanning it: detect its type only once per version of the file
+    const auto &localFileName = fileInfo.absoluteFilePath();
+    const auto modificationTime = fileInfo.lastModified();
+    const auto fileSize = fileInfo.size();
+
+    if (d->mLastMimeTypeFileName != localFileName || d->mLastMimeTypeFileModificationTime != modificationTime ||
+            d->mLastMimeTypeFileSize != fileSize) {
+        d->mLastMimeType = d->mMimeDb.mimeTypeForFile(fileInfo);
+        d->mLastMimeTypeFileName = localFileName;
+        d->mLastMimeTypeFileModificationTime = modificationTime;
+        d->mLastMimeTypeFileSize = fileSize;
+    }
+
+    return d->mLastMimeType;
+}
+
 FileScanner::~FileScanner() = default;
 
 DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo)
@@ -126,20 +129,18 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
 #if KFFileMetaData_FOUND
     const auto &localFileName = scanFile.toLocalFile();
 
-    const auto &fileMimeType = d->mMimeDb.mimeTypeForFile(localFileName);
-    if (!fileMimeType.name().startsWith(QLatin1String("audio/"))) {
+    const auto mimetype = mimeTypeForFile(scanFileInfo).name();
+    if (!mimetype.startsWith(QLatin1String("audio/"))) {
         return newTrack;
     }
 
-    const auto &mimetype = fileMimeType.name();
-
     const QList<KFileMetaData::Extractor*> &exList = d->mAllExtractors.fetchExtractors(mimetype);
 
     if (exList.isEmpty()) {
         // when no extractors exist and we have an audio file, we fallback to filling the minimal
         // set of properties to let Elisa be able to recognise and play the file.
 
-        qCDebug(orgKdeElisaIndexer()) << "FileScanner::shouldScanFile" << scanFile << localFileName << "no extractors" << fileMimeType;
+        qCDebug(orgKdeElisaIndexer()) << "FileScanner::shouldScanFile" << scanFile << localFileName << "no extractors" << mimetype;
 
         newTrack[DataTypes::FileModificationTime] = scanFileInfo.metadataChangeTime();
         newTrack[DataTypes::ResourceRole] = scanFile;
@@ -152,11 +153,12 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
 
     KFileMetaData::Extractor* ex = exList.first();
     KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+                                                 KFileMetaData::ExtractionResult::ExtractMetaData | KFileMetaData::ExtractionResult::ExtractImageData);
 
     ex->extract(&result);
 
     d->mAllProperties = result.properties();
+    d->mAllImages = result.imageData();
 
     scanProperties(localFileName, newTrack);
 
@@ -221,6 +223,8 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         return;
     }
 
+    trackData.internMetaDataStrings();
+
     if (checkEmbeddedCoverImage(localFileName)) {
         trackData[DataTypes::HasEmbeddedCover] = true;
         trackData[DataTypes::ImageUrlRole] = QUrl(QLatin1String("image://cover/") + localFileName);
@@ -251,68 +255,30 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
 QUrl FileScanner::searchForCoverFile(const QString &localFileName)
 {
     const QFileInfo trackFilePath(localFileName);
-    QDir trackFileDir = trackFilePath.absoluteDir();
-
-    static QHash<QString, QUrl> directoryCache;
-    if (directoryCache.contains(trackFileDir.path())) {
-        return directoryCache.value(trackFileDir.path());
-    }
-
-    trackFileDir.setFilter(QDir::Files);
-    trackFileDir.setNameFilters(d->coverFileAllImages);
-    QFileInfoList coverFiles = trackFileDir.entryInfoList();
-
-    if (coverFiles.isEmpty()) {
-        directoryCache.insert(trackFileDir.path(), QUrl());
-        return QUrl();
-    }
-
-    if (coverFiles.length() != 1) {
-        trackFileDir.setNameFilters(d->coverFileNames);
-        coverFiles = trackFileDir.entryInfoList();
-    }
-
-    if (coverFiles.isEmpty()) {
-        trackFileDir.setNameFilters(d->coverFileGlobs);
-        coverFiles = trackFileDir.entryInfoList();
-    }
-
-    if (coverFiles.isEmpty()) {
-        const QString dirNamePattern = QLatin1String("*") + trackFileDir.dirName() + QLatin1String("*");
-        const QString dirNameNoSpaces = QLatin1String("*") + trackFileDir.dirName().remove(QLatin1Char(' ')) + QLatin1String("*");
-        auto filters = buildCoverFileNames({dirNamePattern, dirNameNoSpaces}, d->constCoverExtensions);
-        trackFileDir.setNameFilters(filters);
-        coverFiles = trackFileDir.entryInfoList();
-    }
-
-    if (coverFiles.isEmpty()) {
-        trackFileDir.setNameFilters(d->coverFileAllImages);
-        coverFiles = trackFileDir.entryInfoList();
-    }
-
-    if (coverFiles.isEmpty()) {
-        directoryCache.insert(trackFileDir.path(), QUrl());
-        return QUrl();
-    }
+    return d->mCoverFileCache->coverForDirectory(trackFilePath.absolutePath());
+}
 
-    const QUrl url = QUrl::fromLocalFile(coverFiles.first().absoluteFilePath());
-    directoryCache.insert(trackFileDir.path(), url);
+void FileScanner::setCoverFileCache(CoverFileCache *coverFileCache)
+{
+    d->mCoverFileCache = coverFileCache ? coverFileCache : &d->mOwnCoverFileCache;
+}
 
-    return url;
+void FileScanner::setCoverStore(const CoverStore *coverStore)
+{
+    d->mCoverStore = coverStore;
 }
 
 bool FileScanner::checkEmbeddedCoverImage(const QString &localFileName)
 {
 #if KFFileMetaData_FOUND
-    const auto &mimeType = QMimeDatabase().mimeTypeForFile(localFileName).name();
-    const auto extractors = d->mAllExtractors.fetchExtractors(mimeType);
-
-    for (const auto &extractor : extractors) {
-        KFileMetaData::SimpleExtractionResult result(localFileName, mimeType, KFileMetaData::ExtractionResult::ExtractImageData);
-        extractor->extract(&result);
-        if (!result.imageData().isEmpty()) {
-            return true;
+    // the images were extracted with the metadata in scanOneFile
+    const auto &imageData = d->mAllImages;
+    if (!imageData.isEmpty()) {
+        // store the thumbnails now that the image is in memory: views will not need to read the audio file again
+        if (d->mCoverStore) {
+            d->mCoverStore->storeCover(localFileName, imageData.value(KFileMetaData::EmbeddedImageData::FrontCover, imageData.first()));
         }
+        return true;
     }
 
 #else
@@ -13,7 +13,10 @@
 
 #include <memory>
 
+class CoverFileCache;
+class CoverStore;
 class QFileInfo;
+class QMimeType;
 class QUrl;
 class FileScannerPrivate;
 
@@ -33,8 +36,22 @@ public:
 
     QUrl searchForCoverFile(const QString &localFileName);
 
+    /**
+     * share the cover files found in each directory with other scanners
+     * by default, each scanner has its own cache
+     */
+    void setCoverFileCache(CoverFileCache *coverFileCache);
+
+    /**
+     * store the thumbnails of the embedded covers found while scanning in coverStore
+     * by default, a scanner does not store thumbnails
+     */
+    void setCoverStore(const CoverStore *coverStore);
+
 private:
 
+    const QMimeType &mimeTypeForFile(const QFileInfo &fileInfo);
+
     void scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData);
 
     bool checkEmbeddedCoverImage(const QString &localFileName);
@@ -10,25 +10,218 @@
 
 #include <QUrl>
 #include <QList>
+#include <QMultiHash>
+#include <QTimer>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QDataStream>
 #include <QDebug>
 
 #include <algorithm>
+#include <numeric>
 
 class MediaPlayListPrivate
 {
 public:
 
+    /**
+     * above this count, enqueued entries are resolved when first displayed or in background batches
+     */
+    static constexpr int LazyEnqueueThreshold = 1000;
+
+    static constexpr int ResolutionBatchSize = 100;
+
+    /**
+     * bound the rows of older resolution requests kept behind the latest one
+     */
+    static constexpr int MaximumRequestedRowsCount = 10 * ResolutionBatchSize;
+
+    /**
+     * bound the memory reserved up front for a snapshot whose size is not validated yet
+     */
+    static constexpr qint32 MaximumReservedRestoredEntries = 100000;
+
     QList<MediaPlayListEntry> mData;
 
     QList<DataTypes::TrackDataType> mTrackData;
 
+    QTimer mResolutionTimer;
+
+    /**
+     * rows to resolve before the others, the latest request first
+     * served rows are dropped from the front
+     */
+    QList<int> mRequestedRows;
+
+    int mPendingResolutionsCount = 0;
+
+    int mNextPendingRow = 0;
+
+    /**
+     * rows of the entries by database id, url and title
+     * only rows before mIndexedRowsCount are guaranteed to be up to date
+     * remaining rows are indexed lazily on next lookup
+     */
+    QMultiHash<qulonglong, int> mRowsFromDatabaseId;
+
+    QMultiHash<QUrl, int> mRowsFromUrl;
+
+    QMultiHash<QString, int> mRowsFromTitle;
+
+    int mIndexedRowsCount = 0;
+
+    void addRowToIndex(int row)
+    {
+        const auto &oneEntry = mData[row];
+
+        if (oneEntry.mId != 0) {
+            mRowsFromDatabaseId.insert(oneEntry.mId, row);
+        }
+
+        const auto entryUrl = oneEntry.mTrackUrl.toUrl();
+        if (entryUrl.isValid()) {
+            mRowsFromUrl.insert(entryUrl, row);
+        }
+
+        const auto trackUrl = mTrackData[row].resourceURI();
+        if (trackUrl.isValid() && trackUrl != entryUrl) {
+            mRowsFromUrl.insert(trackUrl, row);
+        }
+
+        mRowsFromTitle.insert(oneEntry.mTitle.toString(), row);
+    }
+
+    void removeRowFromIndex(int row)
+    {
+        const auto &oneEntry = mData[row];
+
+        mRowsFromDatabaseId.remove(oneEntry.mId, row);
+
+        const auto entryUrl = oneEntry.mTrackUrl.toUrl();
+        mRowsFromUrl.remove(entryUrl, row);
+        mRowsFromUrl.remove(mTrackData[row].resourceURI(), row);
+
+        mRowsFromTitle.remove(oneEntry.mTitle.toString(), row);
+    }
+
+    void updateRowsIndex()
+    {
+        for (; mIndexedRowsCount < mData.size(); ++mIndexedRowsCount) {
+            addRowToIndex(mIndexedRowsCount);
+        }
+    }
+
+    /**
+     * to be called before rows starting at firstRow are inserted, removed or moved
+     */
+    void invalidateRowsIndex(int firstRow)
+    {
+        for (int row = firstRow; row < mIndexedRowsCount; ++row) {
+            removeRowFromIndex(row);
+        }
+        mIndexedRowsCount = std::min(mIndexedRowsCount, firstRow);
+    }
+
+    /**
+     * to be called before the id, url or title of an entry are modified
+     */
+    void beginRowUpdate(int row)
+    {
+        if (row < mIndexedRowsCount) {
+            removeRowFromIndex(row);
+        }
+    }
+
+    void endRowUpdate(int row)
+    {
+        if (row < mIndexedRowsCount) {
+            addRowToIndex(row);
+        }
+    }
+
+    void insertRequestedRows(int first, int count)
+    {
+        for (auto &oneRow : mRequestedRows) {
+            if (oneRow >= first) {
+                oneRow += count;
+            }
+        }
+    }
+
+    void removeRequestedRows(int first, int count)
+    {
+        mRequestedRows.removeIf([first, count](const int oneRow) {
+            return oneRow >= first && oneRow < first + count;
+        });
+        for (auto &oneRow : mRequestedRows) {
+            if (oneRow >= first + count) {
+                oneRow -= count;
+            }
+        }
+    }
+
+    void moveRequestedRows(int first, int count, int destinationRow)
+    {
+        for (auto &oneRow : mRequestedRows) {
+            if (oneRow >= first && oneRow < first + count) {
+                oneRow += (destinationRow > first ? destinationRow - count : destinationRow) - first;
+            } else if (destinationRow > first && oneRow >= first + count && oneRow < destinationRow) {
+                oneRow -= count;
+            } else if (destinationRow < first && oneRow >= destinationRow && oneRow < first) {
+                oneRow += count;
+            }
+        }
+    }
+
+    void clearRowsIndex()
+    {
+        mRowsFromDatabaseId.clear();
+        mRowsFromUrl.clear();
+        mRowsFromTitle.clear();
+        mIndexedRowsCount = 0;
+    }
+
+    template <typename Key>
+    [[nodiscard]] QList<int> rowsFromKey(const QMultiHash<Key, int> &rowsIndex, const Key &key)
+    {
+        updateRowsIndex();
+
+        auto result = rowsIndex.values(key);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * rows whose entry may be the track: same database id, same url or same title
+     */
+    [[nodiscard]] QList<int> rowsFromTrack(const DataTypes::TrackDataType &track)
+    {
+        updateRowsIndex();
+
+        // an entry waiting for a track without title could be any entry
+        if (track.find(DataTypes::TrackDataType::key_type::TitleRole) == track.end()) {
+            auto result = QList<int>(mData.size());
+            std::iota(result.begin(), result.end(), 0);
+            return result;
+        }
+
+        auto result = mRowsFromDatabaseId.values(track.databaseId());
+        result.append(mRowsFromUrl.values(track.resourceURI()));
+        result.append(mRowsFromTitle.values(track.title()));
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
 };
 
 MediaPlayList::MediaPlayList(QObject *parent) : QAbstractListModel(parent), d(new MediaPlayListPrivate)
 {
+    d->mResolutionTimer.setInterval(20);
+    d->mResolutionTimer.setSingleShot(true);
+    connect(&d->mResolutionTimer, &QTimer::timeout, this, &MediaPlayList::resolvePendingEntries);
 }
 
 MediaPlayList::~MediaPlayList()
@@ -124,7 +317,10 @@ QVariant MediaPlayList::data(const QModelIndex &index, int role) const
         {
             const auto &trackData = d->mTrackData[index.row()];
             auto titleData = trackData[TrackDataType::key_type::TitleRole];
-            if (titleData.toString().isEmpty()) {
+            if (titleData.toString().isEmpty() && !d->mData[index.row()].mTitle.toString().isEmpty()) {
+                // entries waiting for their resolution only know the title they were enqueued with
+                result = d->mData[index.row()].mTitle;
+            } else if (titleData.toString().isEmpty()) {
                 result = trackData[TrackDataType::key_type::ResourceRole].toUrl().fileName();
             } else {
                 result = titleData;
@@ -244,8 +440,10 @@ bool MediaPlayList::setData(const QModelIndex &index, const QVariant &value, int
     case ColumnsRoles::TitleRole:
     {
         modelModified = true;
+        d->beginRowUpdate(index.row());
         d->mData[index.row()].mTitle = value;
         d->mTrackData[index.row()][static_cast<TrackDataType::key_type>(role)] = value;
+        d->endRowUpdate(index.row());
         Q_EMIT dataChanged(index, index, {role});
 
         break;
@@ -253,7 +451,7 @@ bool MediaPlayList::setData(const QModelIndex &index, const QVariant &value, int
     case ColumnsRoles::ArtistRole:
     {
         modelModified = true;
-        d->mData[index.row()].mArtist = value;
+        d->mData[index.row()].mArtist = MediaPlayListEntry::internedName(value);
         d->mTrackData[index.row()][static_cast<TrackDataType::key_type>(role)] = value;
         Q_EMIT dataChanged(index, index, {role});
 
@@ -270,7 +468,12 @@ bool MediaPlayList::removeRows(int row, int count, const QModelIndex &parent)
 {
     beginRemoveRows(parent, row, row + count - 1);
 
+    d->invalidateRowsIndex(row);
+    d->removeRequestedRows(row, count);
     for (int i = row, cpt = 0; cpt < count; ++i, ++cpt) {
+        if (d->mData[i].mPendingResolution) {
+            --d->mPendingResolutionsCount;
+        }
         d->mData.removeAt(i);
         d->mTrackData.removeAt(i);
     }
@@ -289,6 +492,9 @@ bool MediaPlayList::moveRows(const QModelIndex &sourceParent, int sourceRow, int
         return false;
     }
 
+    d->invalidateRowsIndex(std::min(sourceRow, destinationChild));
+    d->moveRequestedRows(sourceRow, count, destinationChild);
+
     for (auto cptItem = 0; cptItem < count; ++cptItem) {
         if (sourceRow < destinationChild) {
             d->mData.move(sourceRow, destinationChild - 1);
@@ -310,6 +516,9 @@ void MediaPlayList::enqueueRestoredEntries(const QVariantList &newEntries)
         return;
     }
 
+    // local files are resolved together once all entries are restored
+    auto restoredFiles = QList<QUrl>{};
+
     beginInsertRows(QModelIndex(), d->mData.size(), d->mData.size() + newEntries.size() - 1);
     for (auto &oneData : newEntries) {
         auto trackData = oneData.toStringList();
@@ -334,37 +543,68 @@ void MediaPlayList::enqueueRestoredEntries(const QVariantList &newEntries)
         d->mData.push_back(newEntry);
         d->mTrackData.push_back({});
 
-        if (newEntry.mEntryType == ElisaUtils::Radio) {
-            Q_EMIT newEntryInList(newEntry.mId, {}, ElisaUtils::Radio);
-        } else if (newEntry.mTrackUrl.isValid()) {
-            auto entryURL = newEntry.mTrackUrl.toUrl();
-            if (entryURL.isLocalFile()) {
-                auto entryString =  entryURL.toLocalFile();
-                QFileInfo newTrackFile(entryString);
-                if (newTrackFile.exists()) {
-                    d->mData.last().mIsValid = true;
-                    Q_EMIT newEntryInList(0, entryString, ElisaUtils::FileName);
-                } else if (newEntry.mTitle.toString().isEmpty()) {
-                    Q_EMIT newEntryInList(0, entryString, ElisaUtils::FileName);
-                } else {
-                    Q_EMIT newTrackByNameInList(newEntry.mTitle,
-                                                newEntry.mArtist,
-                                                newEntry.mAlbum,
-                                                newEntry.mTrackNumber,
-                                                newEntry.mDiscNumber);
-                }
-            } else {
-                d->mData.last().mIsValid = true;
-            }
-        } else {
-            Q_EMIT newTrackByNameInList(newEntry.mTitle,
-                                        newEntry.mArtist,
-                                        newEntry.mAlbum,
-                                        newEntry.mTrackNumber,
-                                        newEntry.mDiscNumber);
+        validateRestoredEntry(d->mData.size() - 1, restoredFiles);
+    }
+    endInsertRows();
+
+    if (!restoredFiles.isEmpty()) {
+        Q_EMIT newUrlsInList(restoredFiles);
+    }
+}
+
+bool MediaPlayList::enqueueRestoredEntries(QDataStream &snapshot)
+{
+    auto entriesCount = qint32{};
+    snapshot >> entriesCount;
+    if (snapshot.status() != QDataStream::Ok || entriesCount < 0) {
+        return false;
+    }
+
+    // read everything first: a corrupted snapshot must not leave a partial play list
+    auto restoredEntries = QList<MediaPlayListEntry>{};
+    restoredEntries.reserve(std::min(entriesCount, MediaPlayListPrivate::MaximumReservedRestoredEntries));
+    for (int i = 0; i < entriesCount; ++i) {
+        auto restoredId = quint64{};
+        auto restoredEntryType = qint32{};
+        auto restoredFileUrl = QString{};
+        auto restoredTitle = QString{};
+        auto restoredArtist = QString{};
+        auto restoredAlbum = QString{};
+        auto restoredTrackNumber = qint32{};
+        auto restoredDiscNumber = qint32{};
+
+        snapshot >> restoredId >> restoredEntryType >> restoredFileUrl >> restoredTitle >> restoredArtist >> restoredAlbum
+                 >> restoredTrackNumber >> restoredDiscNumber;
+        if (snapshot.status() != QDataStream::Ok || restoredEntryType < ElisaUtils::Album || restoredEntryType > ElisaUtils::Unknown) {
+            return false;
         }
+
+        auto newEntry = MediaPlayListEntry{restoredId, restoredTitle, restoredArtist, restoredAlbum,
+                                           restoredFileUrl.isEmpty() ? QVariant{} : QVariant{QUrl{restoredFileUrl}},
+                                           restoredTrackNumber < 0 ? QVariant{} : QVariant{restoredTrackNumber},
+                                           restoredDiscNumber < 0 ? QVariant{} : QVariant{restoredDiscNumber},
+                                           static_cast<ElisaUtils::PlayListEntryType>(restoredEntryType)};
+        newEntry.mPendingResolution = newEntry.mEntryType;
+        newEntry.mIsRestored = true;
+
+        restoredEntries.push_back(std::move(newEntry));
     }
+
+    if (restoredEntries.isEmpty()) {
+        return true;
+    }
+
+    beginInsertRows(QModelIndex(), d->mData.size(), d->mData.size() + restoredEntries.size() - 1);
+    d->mData.append(std::move(restoredEntries));
+    d->mTrackData.resize(d->mData.size());
+    d->mPendingResolutionsCount += entriesCount;
     endInsertRows();
+
+    if (!d->mResolutionTimer.isActive()) {
+        d->mResolutionTimer.start();
+    }
+
+    return true;
 }
 
 void MediaPlayList::enqueueOneEntry(const DataTypes::EntryData &entryData, int insertAt)
@@ -387,8 +627,13 @@ void MediaPlayList::enqueueMultipleEntries(const DataTypes::EntryDataList &entri
     d->mData.reserve(d->mData.size() + validEntries);
     d->mTrackData.reserve(d->mData.size() + validEntries);
 
+    // resolving a very large batch at once would freeze the user interface
+    const auto isLazyEnqueue = validEntries > MediaPlayListPrivate::LazyEnqueueThreshold;
+
     int i = insertAt < 0 || insertAt > d->mData.size() ? d->mData.size() : insertAt;
     beginInsertRows(QModelIndex(), i, i + validEntries - 1);
+    d->invalidateRowsIndex(i);
+    d->insertRequestedRows(i, validEntries);
     for (const auto &entryData : entriesData) {
         qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueMultipleEntries" << entryData.musicData;
 
@@ -402,6 +647,15 @@ void MediaPlayList::enqueueMultipleEntries(const DataTypes::EntryDataList &entri
             newEntry.mEntryType = ElisaUtils::FileName;
             d->mData.insert(i, std::move(newEntry));
             d->mTrackData.insert(i, {});
+        } else if (isLazyEnqueue) {
+            // only the id and the url are kept until the entry is resolved
+            auto pendingTrackData = TrackDataType{};
+            pendingTrackData[DataTypes::DatabaseIdRole] = entryData.musicData.databaseId();
+            if (trackUrl.isValid()) {
+                pendingTrackData[DataTypes::ResourceRole] = trackUrl;
+            }
+            d->mData.insert(i, MediaPlayListEntry{entryData.musicData.databaseId(), entryData.title, entryData.musicData.elementType()});
+            d->mTrackData.insert(i, std::move(pendingTrackData));
         } else {
             d->mData.insert(i, MediaPlayListEntry{entryData.musicData.databaseId(), entryData.title, entryData.musicData.elementType()});
             const auto &data = entryData.musicData;
@@ -417,7 +671,10 @@ void MediaPlayList::enqueueMultipleEntries(const DataTypes::EntryDataList &entri
             }
         }
 
-        if (trackUrl.isValid()) {
+        if (isLazyEnqueue) {
+            d->mData[i].mPendingResolution = trackUrl.isValid() && !entryData.musicData.hasElementType() ? ElisaUtils::FileName : entryData.musicData.elementType();
+            ++d->mPendingResolutionsCount;
+        } else if (trackUrl.isValid()) {
             qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::enqueueMultipleEntries" << "new url" << trackUrl
                                            << entryData.musicData.hasElementType() << entryData.musicData.elementType();
             Q_EMIT newUrlInList(trackUrl, entryData.musicData.hasElementType() ? entryData.musicData.elementType() : ElisaUtils::FileName);
@@ -427,6 +684,10 @@ void MediaPlayList::enqueueMultipleEntries(const DataTypes::EntryDataList &entri
         ++i;
     }
     endInsertRows();
+
+    if (isLazyEnqueue && !d->mResolutionTimer.isActive()) {
+        d->mResolutionTimer.start();
+    }
 }
 
 void MediaPlayList::clearPlayList()
@@ -438,6 +699,10 @@ void MediaPlayList::clearPlayList()
     beginRemoveRows({}, 0, d->mData.count() - 1);
     d->mData.clear();
     d->mTrackData.clear();
+    d->mRequestedRows.clear();
+    d->mPendingResolutionsCount = 0;
+    d->mNextPendingRow = 0;
+    d->clearRowsIndex();
     endRemoveRows();
 }
 
@@ -478,6 +743,41 @@ QVariantList MediaPlayList::getEntriesForRestore() const
     return result;
 }
 
+void MediaPlayList::writeEntriesForRestore(QDataStream &snapshot) const
+{
+    const auto optionalNumber = [](const QVariant &number) {
+        auto isValid = false;
+        const auto value = number.toInt(&isValid);
+        return isValid ? qint32{value} : qint32{-1};
+    };
+
+    auto savedRows = QList<int>{};
+    savedRows.reserve(d->mData.size());
+    for (int trackIndex = 0; trackIndex < d->mData.size(); ++trackIndex) {
+        if (d->mData[trackIndex].mIsValid || d->mData[trackIndex].mIsRestored) {
+            savedRows.push_back(trackIndex);
+        }
+    }
+
+    snapshot << qint32(savedRows.size());
+    for (const auto trackIndex : savedRows) {
+        const auto &oneEntry = d->mData[trackIndex];
+        const auto &oneTrack = d->mTrackData[trackIndex];
+
+        if (oneTrack.isEmpty()) {
+            // not resolved yet
+            snapshot << quint64{oneEntry.mId} << static_cast<qint32>(oneEntry.mEntryType) << oneEntry.mTrackUrl.toUrl().toString()
+                     << oneEntry.mTitle.toString() << oneEntry.mArtist.toString() << oneEntry.mAlbum.toString()
+                     << optionalNumber(oneEntry.mTrackNumber) << optionalNumber(oneEntry.mDiscNumber);
+        } else {
+            snapshot << quint64{oneTrack.databaseId()} << static_cast<qint32>(oneEntry.mEntryType) << oneTrack.resourceURI().toString()
+                     << oneTrack.title() << oneTrack.artist() << (oneTrack.hasAlbum() ? oneTrack.album() : QString{})
+                     << (oneTrack.hasTrackNumber() ? qint32{oneTrack.trackNumber()} : qint32{-1})
+                     << (oneTrack.hasDiscNumber() ? qint32{oneTrack.discNumber()} : qint32{-1});
+        }
+    }
+}
+
 void MediaPlayList::tracksListAdded(qulonglong newDatabaseId,
                                     const QString &entryTitle,
                                     ElisaUtils::PlayListEntryType databaseIdType,
@@ -488,33 +788,55 @@ void MediaPlayList::tracksListAdded(qulonglong newDatabaseId,
         return;
     }
 
+    const auto isExpandedEntry = [&](const MediaPlayListEntry &oneEntry) {
+        return oneEntry.mEntryType == databaseIdType && oneEntry.mTitle == entryTitle &&
+                (newDatabaseId == 0 || oneEntry.mId == newDatabaseId);
+    };
+
+    const auto expandedEntriesCount = std::count_if(d->mData.cbegin(), d->mData.cend(), isExpandedEntry);
+    if (expandedEntriesCount == 0) {
+        return;
+    }
+
+    d->mData.reserve(d->mData.size() + expandedEntriesCount * (tracks.size() - 1));
+    d->mTrackData.reserve(d->mData.size() + expandedEntriesCount * (tracks.size() - 1));
+
     for (int playListIndex = 0; playListIndex < d->mData.size(); ++playListIndex) {
-        auto &oneEntry = d->mData[playListIndex];
-        if (oneEntry.mEntryType != databaseIdType) {
+        if (!isExpandedEntry(d->mData[playListIndex])) {
             continue;
         }
 
-        if (oneEntry.mTitle != entryTitle) {
-            continue;
+        d->invalidateRowsIndex(playListIndex);
+        if (d->mData[playListIndex].mPendingResolution) {
+            --d->mPendingResolutionsCount;
         }
 
-        if (newDatabaseId != 0 && oneEntry.mId != newDatabaseId) {
-            continue;
+        // the expanded entry becomes its first track and keeps its play state
+        auto &firstEntry = d->mData[playListIndex];
+        const auto playState = firstEntry.mIsPlaying;
+        firstEntry = MediaPlayListEntry{tracks.front()};
+        firstEntry.mEntryType = ElisaUtils::Track;
+        firstEntry.mIsPlaying = playState;
+        d->mTrackData[playListIndex] = tracks.front();
+        Q_EMIT dataChanged(index(playListIndex, 0), index(playListIndex, 0), {});
+
+        // open a gap for the other tracks at once to only move the following rows a single time
+        if (tracks.size() > 1) {
+            beginInsertRows(QModelIndex(), playListIndex + 1, playListIndex + tracks.size() - 1);
+            d->insertRequestedRows(playListIndex + 1, tracks.size() - 1);
+            d->mData.insert(playListIndex + 1, tracks.size() - 1, MediaPlayListEntry{});
+            d->mTrackData.insert(playListIndex + 1, tracks.size() - 1, TrackDataType{});
+            for (int trackIndex = 1; trackIndex < tracks.size(); ++trackIndex) {
+                auto &newEntry = d->mData[playListIndex + trackIndex];
+                newEntry = MediaPlayListEntry{tracks[trackIndex]};
+                newEntry.mEntryType = ElisaUtils::Track;
+                d->mTrackData[playListIndex + trackIndex] = tracks[trackIndex];
+            }
+            endInsertRows();
         }
 
-        beginRemoveRows(QModelIndex(),playListIndex,playListIndex);
-        d->mData.removeAt(playListIndex);
-        d->mTrackData.removeAt(playListIndex);
-        endRemoveRows();
-
-        beginInsertRows(QModelIndex(), playListIndex, playListIndex - 1 + tracks.size());
-        for (int trackIndex = 0; trackIndex < tracks.size(); ++trackIndex) {
-            auto newEntry = MediaPlayListEntry{tracks[trackIndex]};
-            newEntry.mEntryType = ElisaUtils::Track;
-            d->mData.insert(playListIndex + trackIndex, newEntry);
-            d->mTrackData.insert(playListIndex + trackIndex, tracks[trackIndex]);
-        }
-        endInsertRows();
+        // new rows are tracks: continue with the row following the expanded entry
+        playListIndex += tracks.size() - 1;
     }
 }
 
@@ -522,7 +844,7 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
 {
     qCDebug(orgKdeElisaPlayList()) << "MediaPlayList::trackChanged" << track[DataTypes::TitleRole];
 
-    for (int i = 0; i < d->mData.size(); ++i) {
+    for (const auto i : d->rowsFromTrack(track)) {
         auto &oneEntry = d->mData[i];
 
         if (oneEntry.mEntryType != ElisaUtils::Artist && oneEntry.mIsValid) {
@@ -549,7 +871,9 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
                 }
             }
 
+            d->beginRowUpdate(i);
             d->mTrackData[i] = track;
+            d->endRowUpdate(i);
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
             continue;
@@ -558,9 +882,11 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
                 continue;
             }
 
+            d->beginRowUpdate(i);
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->endRowUpdate(i);
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -586,9 +912,11 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
                 continue;
             }
 
+            d->beginRowUpdate(i);
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->endRowUpdate(i);
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -598,9 +926,11 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
                 continue;
             }
 
+            d->beginRowUpdate(i);
             d->mTrackData[i] = track;
             oneEntry.mId = track.databaseId();
             oneEntry.mIsValid = true;
+            d->endRowUpdate(i);
 
             Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
             break;
@@ -608,19 +938,28 @@ void MediaPlayList::trackChanged(const TrackDataType &track)
     }
 }
 
+void MediaPlayList::tracksChanged(const ListTrackDataType &tracks)
+{
+    for (const auto &oneTrack : tracks) {
+        trackChanged(oneTrack);
+    }
+}
+
 void MediaPlayList::trackRemoved(qulonglong trackId)
 {
-    for (int i = 0; i < d->mData.size(); ++i) {
+    for (const auto i : d->rowsFromKey(d->mRowsFromDatabaseId, trackId)) {
         auto &oneEntry = d->mData[i];
 
         if (oneEntry.mIsValid) {
             if (oneEntry.mId == trackId) {
+                d->beginRowUpdate(i);
                 oneEntry.mIsValid = false;
                 oneEntry.mTitle = d->mTrackData[i].title();
-                oneEntry.mArtist = d->mTrackData[i].artist();
-                oneEntry.mAlbum = d->mTrackData[i].album();
+                oneEntry.mArtist = MediaPlayListEntry::internedName(d->mTrackData[i].artist());
+                oneEntry.mAlbum = MediaPlayListEntry::internedName(d->mTrackData[i].album());
                 oneEntry.mTrackNumber = d->mTrackData[i].trackNumber();
                 oneEntry.mDiscNumber = d->mTrackData[i].discNumber();
+                d->endRowUpdate(i);
 
                 Q_EMIT dataChanged(index(i, 0), index(i, 0), {});
 
@@ -633,7 +972,7 @@ void MediaPlayList::trackInError(const QUrl &sourceInError, QMediaPlayer::Error
 {
     Q_UNUSED(playerError)
 
-    for (int i = 0; i < d->mData.size(); ++i) {
+    for (const auto i : d->rowsFromKey(d->mRowsFromUrl, sourceInError)) {
         auto &oneTrack = d->mData[i];
         if (oneTrack.mIsValid) {
             const auto &oneTrackData = d->mTrackData.at(i);
@@ -646,6 +985,147 @@ void MediaPlayList::trackInError(const QUrl &sourceInError, QMediaPlayer::Error
     }
 }
 
+bool MediaPlayList::validateRestoredEntry(int row, QList<QUrl> &restoredFiles)
+{
+    auto &newEntry = d->mData[row];
+
+    if (newEntry.mEntryType == ElisaUtils::Radio) {
+        Q_EMIT newEntryInList(newEntry.mId, {}, ElisaUtils::Radio);
+    } else if (newEntry.mTrackUrl.isValid()) {
+        auto entryURL = newEntry.mTrackUrl.toUrl();
+        if (entryURL.isLocalFile()) {
+            auto entryString =  entryURL.toLocalFile();
+            QFileInfo newTrackFile(entryString);
+            if (newTrackFile.exists()) {
+                newEntry.mIsValid = true;
+                restoredFiles.push_back(QUrl::fromLocalFile(entryString));
+            } else if (newEntry.mTitle.toString().isEmpty()) {
+                restoredFiles.push_back(QUrl::fromLocalFile(entryString));
+            } else {
+                Q_EMIT newTrackByNameInList(newEntry.mTitle,
+                                            newEntry.mArtist,
+                                            newEntry.mAlbum,
+                                            newEntry.mTrackNumber,
+                                            newEntry.mDiscNumber);
+            }
+        } else {
+            newEntry.mIsValid = true;
+        }
+    } else {
+        Q_EMIT newTrackByNameInList(newEntry.mTitle,
+                                    newEntry.mArtist,
+                                    newEntry.mAlbum,
+                                    newEntry.mTrackNumber,
+                                    newEntry.mDiscNumber);
+    }
+
+    return newEntry.mIsValid;
+}
+
+void MediaPlayList::requestEntryResolution(int row, QList<QUrl> &tracksUrls, QList<qulonglong> &tracksIds)
+{
+    auto &oneEntry = d->mData[row];
+    const auto resolutionType = *oneEntry.mPendingResolution;
+    oneEntry.mPendingResolution.reset();
+    --d->mPendingResolutionsCount;
+
+    if (oneEntry.mIsRestored) {
+        oneEntry.mIsRestored = false;
+        if (validateRestoredEntry(row, tracksUrls)) {
+            Q_EMIT dataChanged(index(row, 0), index(row, 0), {ColumnsRoles::IsValidRole});
+        }
+        return;
+    }
+
+    auto entryUrl = oneEntry.mTrackUrl.toUrl();
+    if (!entryUrl.isValid()) {
+        entryUrl = d->mTrackData[row].resourceURI();
+    }
+
+    const auto isTrack = resolutionType == ElisaUtils::Track || resolutionType == ElisaUtils::FileName;
+
+    if (entryUrl.isValid() && isTrack) {
+        tracksUrls.push_back(entryUrl);
+    } else if (entryUrl.isValid()) {
+        Q_EMIT newUrlInList(entryUrl, resolutionType);
+    } else if (resolutionType == ElisaUtils::Track && oneEntry.mId != 0) {
+        tracksIds.push_back(oneEntry.mId);
+    } else {
+        Q_EMIT newEntryInList(oneEntry.mId, oneEntry.mTitle.toString(), resolutionType);
+    }
+}
+
+void MediaPlayList::resolveEntriesFirst(const QList<int> &rows)
+{
+    auto pendingRows = QList<int>{};
+    pendingRows.reserve(rows.size());
+    for (const auto row : rows) {
+        if (row >= 0 && row < d->mData.size() && d->mData[row].mPendingResolution) {
+            pendingRows.push_back(row);
+        }
+    }
+
+    if (pendingRows.isEmpty()) {
+        return;
+    }
+
+    std::sort(pendingRows.begin(), pendingRows.end());
+    pendingRows.erase(std::unique(pendingRows.begin(), pendingRows.end()), pendingRows.end());
+
+    // older requests are served once the latest one is done
+    const auto keptRequestsCount = std::clamp(MediaPlayListPrivate::MaximumRequestedRowsCount - static_cast<int>(pendingRows.size()),
+                                              0, static_cast<int>(d->mRequestedRows.size()));
+    pendingRows.append(d->mRequestedRows.first(keptRequestsCount));
+    d->mRequestedRows = std::move(pendingRows);
+
+    if (!d->mResolutionTimer.isActive()) {
+        d->mResolutionTimer.start();
+    }
+}
+
+void MediaPlayList::resolvePendingEntries()
+{
+    auto remainingResolutions = MediaPlayListPrivate::ResolutionBatchSize;
+    auto tracksUrls = QList<QUrl>{};
+    auto tracksIds = QList<qulonglong>{};
+
+    // displayed entries are resolved first
+    auto servedRequestsCount = 0;
+    for (; servedRequestsCount < d->mRequestedRows.size() && remainingResolutions > 0; ++servedRequestsCount) {
+        const auto row = d->mRequestedRows[servedRequestsCount];
+        if (d->mData[row].mPendingResolution) {
+            requestEntryResolution(row, tracksUrls, tracksIds);
+            --remainingResolutions;
+        }
+    }
+    d->mRequestedRows.remove(0, servedRequestsCount);
+
+    // then all other entries in the background
+    for (int scannedRows = 0; scannedRows < d->mData.size() && remainingResolutions > 0 && d->mPendingResolutionsCount > 0; ++scannedRows) {
+        if (d->mNextPendingRow >= d->mData.size()) {
+            d->mNextPendingRow = 0;
+        }
+
+        if (d->mData[d->mNextPendingRow].mPendingResolution) {
+            requestEntryResolution(d->mNextPendingRow, tracksUrls, tracksIds);
+            --remainingResolutions;
+        }
+
+        ++d->mNextPendingRow;
+    }
+
+    if (!tracksUrls.isEmpty()) {
+        Q_EMIT newUrlsInList(tracksUrls);
+    }
+    if (!tracksIds.isEmpty()) {
+        Q_EMIT newTracksInList(tracksIds);
+    }
+
+    if (d->mPendingResolutionsCount > 0) {
+        d->mResolutionTimer.start();
+    }
+}
+
 QDebug operator<<(const QDebug &stream, const MediaPlayListEntry &data)
 {
     stream << data.mTitle << data.mAlbum << data.mArtist << data.mTrackUrl << data.mTrackNumber << data.mDiscNumber << data.mId << data.mIsValid;
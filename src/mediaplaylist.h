@@ -19,10 +19,12 @@
 #include <utility>
 #include <tuple>
 #include <memory>
+#include <optional>
 
 class MediaPlayListPrivate;
 class MediaPlayListEntry;
 class QDebug;
+class QDataStream;
 
 class ELISALIB_EXPORT MediaPlayList : public QAbstractListModel
 {
@@ -118,8 +120,18 @@ public:
 
     void enqueueRestoredEntries(const QVariantList &newEntries);
 
+    /**
+     * Enqueue entries written by writeEntriesForRestore.
+     * Entries are displayed at once and validated later in background batches.
+     *
+     * @return false if the snapshot is truncated or corrupted, nothing is enqueued in this case
+     */
+    bool enqueueRestoredEntries(QDataStream &snapshot);
+
     [[nodiscard]] QVariantList getEntriesForRestore() const;
 
+    void writeEntriesForRestore(QDataStream &snapshot) const;
+
 Q_SIGNALS:
 
     void newTrackByNameInList(const QVariant &title, const QVariant &artist, const QVariant &album, const QVariant &trackNumber, const QVariant &discNumber);
@@ -131,6 +143,10 @@ Q_SIGNALS:
     void newUrlInList(const QUrl &entryUrl,
                       ElisaUtils::PlayListEntryType databaseIdType);
 
+    void newUrlsInList(const QList<QUrl> &entryUrls);
+
+    void newTracksInList(const QList<qulonglong> &newDatabaseIds);
+
 public Q_SLOTS:
 
     void tracksListAdded(qulonglong newDatabaseId,
@@ -140,6 +156,8 @@ public Q_SLOTS:
 
     void trackChanged(const MediaPlayList::TrackDataType &track);
 
+    void tracksChanged(const MediaPlayList::ListTrackDataType &tracks);
+
     void trackRemoved(qulonglong trackId);
 
     void trackInError(const QUrl &sourceInError, QMediaPlayer::Error playerError);
@@ -154,8 +172,19 @@ public Q_SLOTS:
      */
     void enqueueMultipleEntries(const DataTypes::EntryDataList &entriesData, int insertAt = -1);
 
+    /**
+     * resolve the entries of these rows, like the ones shown by a view, before the other pending ones
+     */
+    void resolveEntriesFirst(const QList<int> &rows);
+
 private:
 
+    bool validateRestoredEntry(int row, QList<QUrl> &restoredFiles);
+
+    void requestEntryResolution(int row, QList<QUrl> &tracksUrls, QList<qulonglong> &tracksIds);
+
+    void resolvePendingEntries();
+
     std::unique_ptr<MediaPlayListPrivate> d;
 };
 
@@ -169,13 +198,13 @@ public:
                        QVariant album, QVariant trackUrl,
                        QVariant trackNumber, QVariant discNumber,
                        ElisaUtils::PlayListEntryType entryType = ElisaUtils::Unknown)
-        : mTitle(std::move(title)), mAlbum(std::move(album)), mArtist(std::move(artist)), mTrackUrl(std::move(trackUrl)),
+        : mTitle(std::move(title)), mAlbum(internedName(album)), mArtist(internedName(artist)), mTrackUrl(std::move(trackUrl)),
           mTrackNumber(std::move(trackNumber)), mDiscNumber(std::move(discNumber)), mId(id), mEntryType(entryType) {
     }
 
     explicit MediaPlayListEntry(const MediaPlayList::TrackDataType &track)
         : mTitle(track[DataTypes::TitleRole]),
-          mAlbum(track[DataTypes::AlbumRole]),
+          mAlbum(internedName(track[DataTypes::AlbumRole])),
           mTrackNumber(track[DataTypes::TrackNumberRole]),
           mDiscNumber(track[DataTypes::DiscNumberRole]),
           mId(track[DataTypes::DatabaseIdRole].toULongLong()),
@@ -191,6 +220,18 @@ public:
         : mTitle(entryTitle), mId(id), mIsValid(true), mEntryType(type) {
     }
 
+    /**
+     * artist and album names are repeated across many entries and share one buffer, see ElisaUtils::internString
+     */
+    static QVariant internedName(const QVariant &name)
+    {
+        if (name.typeId() != QMetaType::QString) {
+            return name;
+        }
+
+        return ElisaUtils::internString(name.toString());
+    }
+
     QVariant mTitle;
 
     QVariant mAlbum;
@@ -211,6 +252,16 @@ public:
 
     MediaPlayList::PlayState mIsPlaying = MediaPlayList::NotPlaying;
 
+    /**
+     * set while the resolution of an entry enqueued in a large batch has not been requested yet
+     */
+    std::optional<ElisaUtils::PlayListEntryType> mPendingResolution;
+
+    /**
+     * set while an entry restored from a snapshot has not been validated yet
+     */
+    bool mIsRestored = false;
+
 };
 
 QDebug operator<<(const QDebug &stream, const MediaPlayListEntry &data);
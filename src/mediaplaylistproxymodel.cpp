@@ -9,6 +9,8 @@
 #include "mediaplaylistproxymodel.h"
 #include "elisautils.h"
 #include "mediaplaylist.h"
+#include "rowsdurations.h"
+#include "shuffledrowsmapping.h"
 #include "playListLogging.h"
 #include "elisa_settings.h"
 #include "config-upnp-qt.h"
@@ -20,6 +22,7 @@
 #include <QDir>
 #include <QMimeDatabase>
 #include <QTimer>
+#include <QDataStream>
 
 #if KFKIO_FOUND
 #include <KIO/OpenUrlJob>
@@ -147,6 +150,24 @@ class MediaPlayListProxyModelPrivate
 {
 public:
 
+    /**
+     * header of the play list snapshot saved in the persistent state
+     * the version is increased each time the layout of the snapshot changes
+     */
+    static constexpr quint32 PlayListSnapshotMagic = 0x456c504c;
+
+    static constexpr quint32 PlayListSnapshotVersion = 1;
+
+    /**
+     * rows following the visible ones that are resolved with them
+     */
+    static constexpr int PrefetchedRowsCount = 20;
+
+    /**
+     * bound the rows a view can ask to resolve at once
+     */
+    static constexpr int MaximumVisibleRowsCount = 200;
+
     MediaPlayList* mPlayListModel;
 
     QPersistentModelIndex mPreviousTrack;
@@ -157,7 +178,7 @@ public:
 
     QPersistentModelIndex mNextTrack;
 
-    QList<int> mRandomMapping;
+    ShuffledRowsMapping mRandomMapping;
 
     QVariantMap mPersistentSettingsForUndo;
 
@@ -178,6 +199,14 @@ public:
     QUrl mLoadedPlayListUrl;
 
     QTimer mDurationChangedTimer;
+
+    /**
+     * Durations of the tracks in proxy order, in milliseconds
+     * Row insertions, removals, moves and data changes update them, layout changes and resets rebuild them on next use
+     */
+    RowsDurations mTracksDurations;
+
+    bool mTracksDurationsAreValid = false;
 };
 
 MediaPlayListProxyModel::MediaPlayListProxyModel(QObject *parent) : QAbstractProxyModel (parent),
@@ -191,6 +220,48 @@ MediaPlayListProxyModel::MediaPlayListProxyModel(QObject *parent) : QAbstractPro
         Q_EMIT remainingTracksDurationChanged();
         Q_EMIT totalTracksDurationChanged();
     });
+
+    connect(this, &MediaPlayListProxyModel::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+        if (!d->mTracksDurationsAreValid) {
+            return;
+        }
+        auto newDurations = QList<qint64>{};
+        newDurations.reserve(last - first + 1);
+        for (int row = first; row <= last; ++row) {
+            newDurations.push_back(trackDuration(row));
+        }
+        d->mTracksDurations.insertRows(first, newDurations);
+    });
+    connect(this, &MediaPlayListProxyModel::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+        if (!d->mTracksDurationsAreValid) {
+            return;
+        }
+        d->mTracksDurations.removeRows(first, last - first + 1);
+    });
+    connect(this, &MediaPlayListProxyModel::rowsMoved, this, [this](const QModelIndex &, int start, int end, const QModelIndex &, int destinationRow) {
+        if (!d->mTracksDurationsAreValid) {
+            return;
+        }
+        const auto movedRowsCount = end - start + 1;
+        d->mTracksDurations.moveRows(start, movedRowsCount, destinationRow > start ? destinationRow - movedRowsCount : destinationRow);
+    });
+    connect(this, &MediaPlayListProxyModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+        if (!d->mTracksDurationsAreValid || (!roles.isEmpty() && !roles.contains(MediaPlayList::DurationRole))) {
+            return;
+        }
+        if (bottomRight.row() >= d->mTracksDurations.size()) {
+            d->mTracksDurationsAreValid = false;
+            return;
+        }
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+            d->mTracksDurations.setDuration(row, trackDuration(row));
+        }
+    });
+    const auto invalidateTracksDurations = [this]() {
+        d->mTracksDurationsAreValid = false;
+    };
+    connect(this, &MediaPlayListProxyModel::layoutChanged, this, invalidateTracksDurations);
+    connect(this, &MediaPlayListProxyModel::modelReset, this, invalidateTracksDurations);
 }
 
 MediaPlayListProxyModel::~MediaPlayListProxyModel()
@@ -245,8 +316,8 @@ QModelIndex MediaPlayListProxyModel::mapToSource(const QModelIndex &proxyIndex)
 
 int MediaPlayListProxyModel::mapRowToSource(const int proxyRow) const
 {
-    if (d->mRandomMapping.size() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
-        return d->mRandomMapping.at(proxyRow);
+    if (!d->mRandomMapping.isEmpty() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        return d->mRandomMapping.sourceRow(proxyRow);
     } else {
         return proxyRow;
     }
@@ -255,7 +326,7 @@ int MediaPlayListProxyModel::mapRowToSource(const int proxyRow) const
 int MediaPlayListProxyModel::mapRowFromSource(const int sourceRow) const
 {
     if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
-        return d->mRandomMapping.indexOf(sourceRow);
+        return d->mRandomMapping.proxyRow(sourceRow);
     } else {
         return sourceRow;
     }
@@ -267,7 +338,7 @@ int MediaPlayListProxyModel::rowCount(const QModelIndex &parent) const
         if (parent.isValid()) {
             return 0;
         }
-        return d->mRandomMapping.count();
+        return d->mRandomMapping.size();
     } else {
         return d->mPlayListModel->rowCount(parent);
     }
@@ -379,8 +450,9 @@ void MediaPlayListProxyModel::setShuffleMode(const MediaPlayListProxyModel::Shuf
                 from.reserve(playListSize);
                 QModelIndexList to;
                 to.reserve(playListSize);
+                const auto sourceRows = d->mRandomMapping.sourceRows();
                 for (int i = 0; i < playListSize; ++i) {
-                    to.append(index(d->mRandomMapping.at(i), 0));
+                    to.append(index(sourceRows.at(i), 0));
                     from.append(index(i, 0));
                 }
                 changePersistentIndexList(from, to);
@@ -393,11 +465,11 @@ void MediaPlayListProxyModel::setShuffleMode(const MediaPlayListProxyModel::Shuf
                 from.reserve(playListSize);
                 to.reserve(playListSize);
 
-                d->mRandomMapping.clear();
-                d->mRandomMapping.reserve(playListSize);
+                QList<int> randomMapping;
+                randomMapping.reserve(playListSize);
 
                 for (int i = 0; i < playListSize; ++i) {
-                    d->mRandomMapping.append(i);
+                    randomMapping.append(i);
                     to.append(index(i,0));
                 }
 
@@ -405,17 +477,17 @@ void MediaPlayListProxyModel::setShuffleMode(const MediaPlayListProxyModel::Shuf
                     // Adding the current track first if it is not the only one
                     if (playListSize > 1) {
                         if (currentTrackRow() != 0) {
-                            std::swap(d->mRandomMapping[0], d->mRandomMapping[currentTrackRow()]);
+                            std::swap(randomMapping[0], randomMapping[currentTrackRow()]);
                         }
-                        from.append(index(d->mRandomMapping.at(0), 0));
+                        from.append(index(randomMapping.at(0), 0));
                     }
                     // Fisher-Yates algorithm
                     for (int i = 1;  i < playListSize - 1; ++i) {
                         const int swapIndex = d->mRandomGenerator.bounded(i, playListSize);
-                        std::swap(d->mRandomMapping[i], d->mRandomMapping[swapIndex]);
-                        from.append(index(d->mRandomMapping.at(i), 0));
+                        std::swap(randomMapping[i], randomMapping[swapIndex]);
+                        from.append(index(randomMapping.at(i), 0));
                     }
-                    from.append(index(d->mRandomMapping.at(playListSize - 1), 0));
+                    from.append(index(randomMapping.at(playListSize - 1), 0));
                 } else if (value == MediaPlayListProxyModel::Shuffle::Album) { // album shuffle
                     QHash<int, QList<int>> indexPerAlbumId;
                     int currentAlbumId = data(d->mCurrentTrack,  MediaPlayList::AlbumIdRole).toInt();
@@ -447,17 +519,16 @@ void MediaPlayListProxyModel::setShuffleMode(const MediaPlayListProxyModel::Shuf
 
                     std::shuffle(++albumIds.begin(), albumIds.end(), d->mRandomGenerator);
 
-                    QList<int> newRandomMapping;
-                    newRandomMapping.reserve(playListSize);
+                    randomMapping.clear();
                     for (int albumId : albumIds) {
                         const auto &sourceRows = indexPerAlbumId[albumId];
                         for (int sourceRow : sourceRows) {
                             from.append(index(sourceRow, 0));
-                            newRandomMapping.append(sourceRow);
+                            randomMapping.append(sourceRow);
                         }
                     }
-                    d->mRandomMapping = newRandomMapping;
                 }
+                d->mRandomMapping.assign(randomMapping);
                 changePersistentIndexList(from, to);
             }
             d->mCurrentPlayListPosition = d->mCurrentTrack.row();
@@ -496,24 +567,19 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
 {
     if (d->mShuffleMode == MediaPlayListProxyModel::Shuffle::Track) { // track shuffle
         const auto newItemsCount = end - start + 1;
-        d->mRandomMapping.reserve(rowCount() + newItemsCount);
+
+        // old track indices after start are shifted by the mapping itself
+        d->mRandomMapping.insertSourceRows(start, newItemsCount);
 
         if (rowCount() == 0) {
             beginInsertRows(parent, start, end);
             for (int i = 0; i < newItemsCount; ++i) {
                 //QRandomGenerator.bounded(int) is exclusive, thus + 1
-                const auto random = d->mRandomGenerator.bounded(d->mRandomMapping.count()+1);
-                d->mRandomMapping.insert(random, start + i);
+                const auto random = d->mRandomGenerator.bounded(d->mRandomMapping.size()+1);
+                d->mRandomMapping.placeSourceRow(start + i, random);
             }
             endInsertRows();
         } else {
-            if (start <= rowCount()) {
-                // First increment old track indices
-                std::transform(d->mRandomMapping.begin(), d->mRandomMapping.end(), d->mRandomMapping.begin(), [=](const int sourceRow) {
-                    return sourceRow < start ? sourceRow : sourceRow + newItemsCount;
-                });
-            }
-
             const bool enqueueAfterCurrentTrack = mapRowFromSource(start - 1) == d->mCurrentTrack.row();
 
             if (enqueueAfterCurrentTrack) {
@@ -524,7 +590,7 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 const int proxyStart = d->mCurrentTrack.row() + 1;
                 beginInsertRows(parent, proxyStart, proxyStart + newItemsCount - 1);
                 for (int sourceRow : shuffledSourceRows) {
-                    d->mRandomMapping.insert(proxyStart, sourceRow);
+                    d->mRandomMapping.placeSourceRow(sourceRow, proxyStart);
                 }
                 endInsertRows();
             } else {
@@ -533,14 +599,16 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                     //QRandomGenerator.bounded(int) is exclusive, thus + 1
                     const auto random = d->mRandomGenerator.bounded(lowerBound, rowCount() + 1);
                     beginInsertRows(parent, random, random);
-                    d->mRandomMapping.insert(random, start + i);
+                    d->mRandomMapping.placeSourceRow(start + i, random);
                     endInsertRows();
                 }
             }
         }
     } else if (d->mShuffleMode == MediaPlayListProxyModel::Shuffle::Album) { // album shuffle
         const auto newItemsCount = end - start + 1;
-        d->mRandomMapping.reserve(rowCount() + newItemsCount);
+
+        // old track indices after start are shifted by the mapping itself
+        d->mRandomMapping.insertSourceRows(start, newItemsCount);
 
         // This is used to generate fictive (negative) albumIds for
         // tracks that don't belong to an album; this will allow to
@@ -570,17 +638,13 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
             std::shuffle(newAlbumIds.begin(), newAlbumIds.end(), d->mRandomGenerator);
             beginInsertRows(parent, start, end);
             for (int albumId : newAlbumIds) {
-                d->mRandomMapping += newIndexPerAlbumId.take(albumId);
+                const auto sourceRows = newIndexPerAlbumId.take(albumId);
+                for (int sourceRow : sourceRows) {
+                    d->mRandomMapping.placeSourceRow(sourceRow, d->mRandomMapping.size());
+                }
             }
             endInsertRows();
         } else {
-            if (start <= rowCount()) {
-                // First increment old track indices
-                std::transform(d->mRandomMapping.begin(), d->mRandomMapping.end(), d->mRandomMapping.begin(), [=](const int sourceRow) {
-                    return sourceRow < start ? sourceRow : sourceRow + newItemsCount;
-                });
-            }
-
             const bool enqueueAfterCurrentTrack = mapRowFromSource(start - 1) == d->mCurrentTrack.row();
 
             if (enqueueAfterCurrentTrack) {
@@ -591,7 +655,7 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 for (int albumId : newAlbumIds) {
                     const auto &sourceRows = newIndexPerAlbumId[albumId];
                     for (int sourceRow : sourceRows) {
-                        d->mRandomMapping.insert(proxyRow++, sourceRow);
+                        d->mRandomMapping.placeSourceRow(sourceRow, proxyRow++);
                     }
                 }
                 endInsertRows();
@@ -621,15 +685,20 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 // Also add last index value as possible insertion point
                 insertIndexes.append(rowCount());
 
+                // the tracks of an expanded album follow its first track that replaced the album entry
+                const int previousRow = start > 0 ? mapRowFromSource(start - 1) : -1;
+                const int previousAlbumId = start > 0 ? d->mPlayListModel->data(d->mPlayListModel->index(start - 1, 0), MediaPlayList::AlbumIdRole).toInt() : 0;
+
                 for (int newAlbumId : newAlbumIds) {
                     const QList<int> &newAlbumTrackIds = newIndexPerAlbumId[newAlbumId];
 
                     // pick a random spot to insert the new album
-                    const auto random = insertIndexes[d->mRandomGenerator.bounded(insertIndexes.count())];
+                    const auto random = (newAlbumId > 0 && newAlbumId == previousAlbumId && previousRow > d->mCurrentTrack.row()) ?
+                        previousRow + 1 : insertIndexes[d->mRandomGenerator.bounded(insertIndexes.count())];
 
                     beginInsertRows(parent, random, random + newAlbumTrackIds.count() - 1);
                     for (int j = 0; j < newAlbumTrackIds.count(); ++j) {
-                        d->mRandomMapping.insert(random + j, newAlbumTrackIds[j]);
+                        d->mRandomMapping.placeSourceRow(newAlbumTrackIds[j], random + j);
                     }
                     endInsertRows();
 
@@ -678,20 +747,13 @@ void MediaPlayListProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &pare
             beginRemoveRows(parent, start, end);
             d->mRandomMapping.clear();
             endRemoveRows();
-        }
-        int row = 0;
-        auto it = d->mRandomMapping.begin();
-        while (it != d->mRandomMapping.end()) {
-            if (*it >= start && *it <= end){
+        } else {
+            // removing from the end keeps the remaining source rows valid, the following ones are shifted by the mapping
+            for (int sourceRow = end; sourceRow >= start; --sourceRow) {
+                const auto row = d->mRandomMapping.proxyRow(sourceRow);
                 beginRemoveRows(parent, row, row);
-                it = d->mRandomMapping.erase(it);
+                d->mRandomMapping.removeSourceRow(sourceRow);
                 endRemoveRows();
-            } else {
-                if (*it > end) {
-                    *it = *it - end + start - 1;
-                }
-                it++;
-                row++;
             }
         }
     } else {
@@ -771,6 +833,14 @@ void MediaPlayListProxyModel::sourceDataChanged(const QModelIndex &topLeft, cons
 
         d->mDurationChangedTimer.start();
         Q_EMIT dataChanged(index(proxyRow, 0), index(proxyRow, 0), roles);
+
+        // an expanded album or artist becomes its first track in place
+        if (d->mTriggerPlay == ElisaUtils::TriggerPlay && index(proxyRow, 0).data(MediaPlayList::ResourceRole).toUrl().isValid()) {
+            switchTo(proxyRow);
+            d->mTriggerPlay = ElisaUtils::DoNotTriggerPlay;
+            Q_EMIT requestPlay();
+        }
+
         if (proxyRow == d->mCurrentTrack.row()) {
             Q_EMIT currentTrackDataChanged();
         } else if (proxyRow == d->mNextTrack.row()) {
@@ -799,20 +869,42 @@ void MediaPlayListProxyModel::sourceHeaderDataChanged(Qt::Orientation orientatio
 
 int MediaPlayListProxyModel::totalTracksDuration() const
 {
-    int time = 0;
-    for (int i = 0; i < rowCount(); i++) {
-        time += d->mPlayListModel->data(index(i, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
-    }
-    return time;
+    updateTracksDurations();
+
+    return static_cast<int>(d->mTracksDurations.totalDuration());
 }
 
 int MediaPlayListProxyModel::remainingTracksDuration() const
 {
-    int time = 0;
-    for (int i = d->mCurrentTrack.row(); i < rowCount(); i++) {
-        time += d->mPlayListModel->data(index(i, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
+    updateTracksDurations();
+
+    const auto firstRemainingRow = std::clamp(d->mCurrentTrack.row(), 0, d->mTracksDurations.size());
+    return static_cast<int>(d->mTracksDurations.totalDuration() - d->mTracksDurations.durationOfFirstRows(firstRemainingRow));
+}
+
+qint64 MediaPlayListProxyModel::trackDuration(int row) const
+{
+    return d->mPlayListModel->data(d->mPlayListModel->index(mapRowToSource(row), 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
+}
+
+void MediaPlayListProxyModel::updateTracksDurations() const
+{
+    if (d->mTracksDurationsAreValid) {
+        return;
+    }
+
+    const auto playListSize = rowCount();
+
+    auto allDurations = QList<qint64>{};
+    allDurations.reserve(playListSize);
+    for (int row = 0; row < playListSize; ++row) {
+        allDurations.push_back(trackDuration(row));
     }
-    return time;
+
+    d->mTracksDurations.clear();
+    d->mTracksDurations.insertRows(0, allDurations);
+
+    d->mTracksDurationsAreValid = true;
 }
 
 int MediaPlayListProxyModel::remainingTracks() const
@@ -968,7 +1060,7 @@ void MediaPlayListProxyModel::moveRow(int from, int to)
 
     if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
         beginMoveRows({}, from, from, {}, from < to ? to + 1 : to);
-        d->mRandomMapping.move(from, to);
+        d->mRandomMapping.moveProxyRow(from, to);
         endMoveRows();
     } else {
         d->mPlayListModel->moveRows({}, from, 1, {}, from < to ? to + 1 : to);
@@ -1044,6 +1136,34 @@ void MediaPlayListProxyModel::determineAndNotifyPreviousAndNextTracks()
     if (d->mNextTrack != mOldNextTrack) {
         Q_EMIT nextTrackChanged(d->mNextTrack);
     }
+
+    // the player reads the current and next tracks even when they are not displayed
+    auto playedRows = QList<int>{};
+    if (d->mCurrentTrack.isValid()) {
+        playedRows.push_back(mapRowToSource(d->mCurrentTrack.row()));
+    }
+    if (d->mNextTrack.isValid()) {
+        playedRows.push_back(mapRowToSource(d->mNextTrack.row()));
+    }
+    if (!playedRows.isEmpty()) {
+        d->mPlayListModel->resolveEntriesFirst(playedRows);
+    }
+}
+
+void MediaPlayListProxyModel::setVisibleRows(int firstRow, int lastRow)
+{
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min({lastRow + MediaPlayListProxyModelPrivate::PrefetchedRowsCount,
+                        firstRow + MediaPlayListProxyModelPrivate::MaximumVisibleRowsCount - 1,
+                        rowCount() - 1});
+
+    auto sourceRows = QList<int>{};
+    sourceRows.reserve(std::max(lastRow - firstRow + 1, 0));
+    for (int row = firstRow; row <= lastRow; ++row) {
+        sourceRows.push_back(mapRowToSource(row));
+    }
+
+    d->mPlayListModel->resolveEntriesFirst(sourceRows);
 }
 
 int MediaPlayListProxyModel::indexForTrackUrl(const QUrl &url)
@@ -1071,7 +1191,14 @@ void MediaPlayListProxyModel::clearPlayList()
     if (rowCount() == 0) {
         return;
     }
-    d->mPersistentSettingsForUndo = persistentState();
+    // undo restores entries that were just valid: keep the format validating them at once
+    d->mPersistentSettingsForUndo = {
+        {QStringLiteral("playList"), d->mPlayListModel->getEntriesForRestore()},
+        {QStringLiteral("shuffleMode"), QVariant::fromValue(d->mShuffleMode)},
+        {QStringLiteral("randomMapping"), getRandomMappingForRestore()},
+        {QStringLiteral("currentTrack"), d->mCurrentPlayListPosition},
+        {QStringLiteral("repeatMode"), QVariant::fromValue(d->mRepeatMode)},
+    };
     d->mCurrentPlayListPosition = -1;
     d->mCurrentTrack = QPersistentModelIndex{};
     notifyCurrentTrackChanged();
@@ -1185,9 +1312,8 @@ QVariantMap MediaPlayListProxyModel::persistentState() const
 {
     QVariantMap currentState;
 
-    currentState[QStringLiteral("playList")] = d->mPlayListModel->getEntriesForRestore();
+    currentState[QStringLiteral("playListSnapshot")] = getPlayListSnapshotForRestore();
     currentState[QStringLiteral("shuffleMode")] = d->mShuffleMode;
-    currentState[QStringLiteral("randomMapping")] = getRandomMappingForRestore();
     currentState[QStringLiteral("currentTrack")] = d->mCurrentPlayListPosition;
     currentState[QStringLiteral("repeatMode")] = d->mRepeatMode;
 
@@ -1198,15 +1324,27 @@ void MediaPlayListProxyModel::setPersistentState(const QVariantMap &persistentSt
 {
     qCDebug(orgKdeElisaPlayList()) << "MediaPlayListProxyModel::setPersistentState" << persistentStateValue;
 
-    auto playListIt = persistentStateValue.find(QStringLiteral("playList"));
-    if (playListIt != persistentStateValue.end()) {
-        d->mPlayListModel->enqueueRestoredEntries(playListIt.value().toList());
-    }
-
     auto shuffleModeStoredValue = persistentStateValue.find(QStringLiteral("shuffleMode"));
-    auto shuffleRandomMappingIt = persistentStateValue.find(QStringLiteral("randomMapping"));
-    if (shuffleModeStoredValue != persistentStateValue.end() && shuffleRandomMappingIt != persistentStateValue.end()) {
-        restoreShuffleMode(shuffleModeStoredValue->value<Shuffle>(), shuffleRandomMappingIt.value().toList());
+    const auto shuffleMode = shuffleModeStoredValue != persistentStateValue.end() ? shuffleModeStoredValue->value<Shuffle>() : Shuffle::NoShuffle;
+
+    auto playListSnapshotIt = persistentStateValue.find(QStringLiteral("playListSnapshot"));
+    if (playListSnapshotIt == persistentStateValue.end() || !restorePlayListSnapshot(playListSnapshotIt->toByteArray(), shuffleMode)) {
+        // state saved by previous versions or for undo
+        auto playListIt = persistentStateValue.find(QStringLiteral("playList"));
+        if (playListIt != persistentStateValue.end()) {
+            d->mPlayListModel->enqueueRestoredEntries(playListIt.value().toList());
+        }
+
+        auto shuffleRandomMappingIt = persistentStateValue.find(QStringLiteral("randomMapping"));
+        if (shuffleModeStoredValue != persistentStateValue.end() && shuffleRandomMappingIt != persistentStateValue.end()) {
+            const auto storedMapping = shuffleRandomMappingIt.value().toList();
+            auto mapping = QList<int>{};
+            mapping.reserve(storedMapping.size());
+            for (const auto &oneRow : storedMapping) {
+                mapping.push_back(oneRow.toInt());
+            }
+            restoreShuffleMode(shuffleMode, mapping);
+        }
     }
 
     auto playerCurrentTrack = persistentStateValue.find(QStringLiteral("currentTrack"));
@@ -1231,48 +1369,115 @@ void MediaPlayListProxyModel::setPersistentState(const QVariantMap &persistentSt
     Q_EMIT persistentStateChanged();
 }
 
+QByteArray MediaPlayListProxyModel::getPlayListSnapshotForRestore() const
+{
+    QByteArray snapshot;
+    QDataStream snapshotStream(&snapshot, QIODevice::WriteOnly);
+    snapshotStream.setVersion(QDataStream::Qt_6_0);
+
+    snapshotStream << MediaPlayListProxyModelPrivate::PlayListSnapshotMagic << MediaPlayListProxyModelPrivate::PlayListSnapshotVersion;
+
+    d->mPlayListModel->writeEntriesForRestore(snapshotStream);
+
+    if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        snapshotStream << d->mRandomMapping.sourceRows();
+    } else {
+        snapshotStream << QList<int>{};
+    }
+
+    return qCompress(snapshot);
+}
+
+bool MediaPlayListProxyModel::restorePlayListSnapshot(const QByteArray &compressedSnapshot, Shuffle mode)
+{
+    const auto snapshot = qUncompress(compressedSnapshot);
+    QDataStream snapshotStream(snapshot);
+    snapshotStream.setVersion(QDataStream::Qt_6_0);
+
+    auto magic = quint32{};
+    auto version = quint32{};
+    snapshotStream >> magic >> version;
+    if (snapshotStream.status() != QDataStream::Ok || magic != MediaPlayListProxyModelPrivate::PlayListSnapshotMagic ||
+            version != MediaPlayListProxyModelPrivate::PlayListSnapshotVersion) {
+        qCWarning(orgKdeElisaPlayList()) << "MediaPlayListProxyModel::restorePlayListSnapshot" << "invalid play list snapshot" << magic << version;
+        return false;
+    }
+
+    if (!d->mPlayListModel->enqueueRestoredEntries(snapshotStream)) {
+        qCWarning(orgKdeElisaPlayList()) << "MediaPlayListProxyModel::restorePlayListSnapshot" << "corrupted play list snapshot";
+        return false;
+    }
+
+    auto mapping = QList<int>{};
+    snapshotStream >> mapping;
+    if (snapshotStream.status() != QDataStream::Ok) {
+        mapping.clear();
+    }
+    restoreShuffleMode(mode, mapping);
+
+    return true;
+}
+
 QVariantList MediaPlayListProxyModel::getRandomMappingForRestore() const
 {
     QVariantList randomMapping;
 
     if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
-        randomMapping.reserve(d->mRandomMapping.count());
-        for (int i = 0; i < d->mRandomMapping.count(); ++i) {
-            randomMapping.append(QVariant(d->mRandomMapping[i]));
+        const auto sourceRows = d->mRandomMapping.sourceRows();
+        randomMapping.reserve(sourceRows.count());
+        for (int sourceRow : sourceRows) {
+            randomMapping.append(QVariant(sourceRow));
         }
     }
 
     return randomMapping;
 }
 
-void MediaPlayListProxyModel::restoreShuffleMode(MediaPlayListProxyModel::Shuffle mode, QVariantList mapping)
+void MediaPlayListProxyModel::restoreShuffleMode(MediaPlayListProxyModel::Shuffle mode, const QList<int> &mapping)
 {
     auto playListSize = rowCount();
 
-    if (mode != MediaPlayListProxyModel::Shuffle::NoShuffle && mapping.count() == playListSize && d->mRandomMapping.isEmpty()) {
-        Q_EMIT layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
-
-        QModelIndexList from, to;
-        from.reserve(playListSize);
-        to.reserve(playListSize);
-        d->mRandomMapping.clear();
-        d->mRandomMapping.reserve(playListSize);
+    if (mode == MediaPlayListProxyModel::Shuffle::NoShuffle || !d->mRandomMapping.isEmpty()) {
+        return;
+    }
 
-        for (int i = 0; i < playListSize; ++i) {
-            d->mRandomMapping.append(mapping[i].toInt());
-            from.append(index(mapping[i].toInt(), 0));
-            to.append(index(i, 0));
+    // a stored mapping must give each row of the play list exactly once
+    auto isValidMapping = mapping.count() == playListSize;
+    auto seenRows = QList<bool>(playListSize, false);
+    for (int i = 0; isValidMapping && i < playListSize; ++i) {
+        const auto oneRow = mapping[i];
+        isValidMapping = oneRow >= 0 && oneRow < playListSize && !seenRows[oneRow];
+        if (isValidMapping) {
+            seenRows[oneRow] = true;
         }
-        changePersistentIndexList(from, to);
+    }
 
-        d->mShuffleMode = mode;
+    if (!isValidMapping) {
+        qCWarning(orgKdeElisaPlayList()) << "MediaPlayListProxyModel::restoreShuffleMode" << "invalid shuffled rows, shuffling again";
+        setShuffleMode(mode);
+        return;
+    }
 
-        Q_EMIT layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+    Q_EMIT layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
-        Q_EMIT shuffleModeChanged();
-        Q_EMIT remainingTracksChanged();
-        Q_EMIT remainingTracksDurationChanged();
+    QModelIndexList from, to;
+    from.reserve(playListSize);
+    to.reserve(playListSize);
+
+    for (int i = 0; i < playListSize; ++i) {
+        from.append(index(mapping[i], 0));
+        to.append(index(i, 0));
     }
+    d->mRandomMapping.assign(mapping);
+    changePersistentIndexList(from, to);
+
+    d->mShuffleMode = mode;
+
+    Q_EMIT layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+    Q_EMIT shuffleModeChanged();
+    Q_EMIT remainingTracksChanged();
+    Q_EMIT remainingTracksDurationChanged();
 }
 
 bool MediaPlayListProxyModel::partiallyLoaded() const
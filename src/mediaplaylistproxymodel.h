@@ -249,6 +249,11 @@ public Q_SLOTS:
 
     void switchToTrackUrl(const QUrl &url, ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
 
+    /**
+     * rows shown by a view: their entries and the following ones are resolved first
+     */
+    void setVisibleRows(int firstRow, int lastRow);
+
 Q_SIGNALS:
 
     void previousTrackChanged(const QPersistentModelIndex &previousTrack);
@@ -343,9 +348,17 @@ private:
 
     void determineAndNotifyPreviousAndNextTracks();
 
+    [[nodiscard]] qint64 trackDuration(int row) const;
+
+    void updateTracksDurations() const;
+
     QVariantList getRandomMappingForRestore() const;
 
-    void restoreShuffleMode(Shuffle mode, QVariantList mapping);
+    [[nodiscard]] QByteArray getPlayListSnapshotForRestore() const;
+
+    bool restorePlayListSnapshot(const QByteArray &compressedSnapshot, Shuffle mode);
+
+    void restoreShuffleMode(Shuffle mode, const QList<int> &mapping);
 
     void loadLocalFile(DataTypes::EntryDataList &newTracks, QSet<QString> &processedFiles, const QFileInfo &fileInfo);
 
@@ -10,13 +10,33 @@
 #include "filewriter.h"
 
 #include <QFileInfo>
+#include <QThread>
 
 class ModelDataLoaderPrivate
 {
 public:
 
+    [[nodiscard]] DatabaseInterface *queryDatabase() const
+    {
+        return mReadOnlyDatabase ? mReadOnlyDatabase : mDatabase;
+    }
+
+    /**
+     * play events are buffered by the database instance writing them, read-only ones cannot see them
+     */
+    void flushPlayStatistics() const
+    {
+        if (mDatabase->thread() == QThread::currentThread()) {
+            mDatabase->flushPlayStatistics();
+        } else {
+            QMetaObject::invokeMethod(mDatabase, &DatabaseInterface::flushPlayStatistics, Qt::BlockingQueuedConnection);
+        }
+    }
+
     DatabaseInterface *mDatabase = nullptr;
 
+    DatabaseInterface *mReadOnlyDatabase = nullptr;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ModelDataLoader::FilterType mFilterType = ModelDataLoader::FilterType::UnknownFilter;
@@ -79,6 +99,11 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
             this, &ModelDataLoader::clearedDatabase);
 }
 
+void ModelDataLoader::setReadOnlyDatabase(DatabaseInterface *database)
+{
+    d->mReadOnlyDatabase = database;
+}
+
 void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
 {
     if (!d->mDatabase) {
@@ -90,20 +115,20 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        Q_EMIT allAlbumsData(d->queryDatabase()->allAlbumsData());
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+        Q_EMIT allArtistsData(d->queryDatabase()->allArtistsData());
         break;
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
-        Q_EMIT allGenresData(d->mDatabase->allGenresData());
+        Q_EMIT allGenresData(d->queryDatabase()->allGenresData());
         break;
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+        Q_EMIT allTracksData(d->queryDatabase()->allTracksData());
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -111,7 +136,7 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     case ElisaUtils::PlayList:
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadiosData(d->mDatabase->allRadiosData());
+        Q_EMIT allRadiosData(d->queryDatabase()->allRadiosData());
         break;
     }
 }
@@ -138,7 +163,7 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->albumData(databaseId));
+        Q_EMIT allTracksData(d->queryDatabase()->albumData(databaseId));
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -161,10 +186,10 @@ void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, co
     switch (dataType)
     {
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsDataByGenre(genre));
+        Q_EMIT allArtistsData(d->queryDatabase()->allArtistsDataByGenre(genre));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromGenre(genre));
+        Q_EMIT allTracksData(d->queryDatabase()->tracksDataFromGenre(genre));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Composer:
@@ -191,10 +216,10 @@ void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, c
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByArtist(artist));
+        Q_EMIT allAlbumsData(d->queryDatabase()->allAlbumsDataByArtist(artist));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromAuthor(artist));
+        Q_EMIT allTracksData(d->queryDatabase()->tracksDataFromAuthor(artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -222,10 +247,10 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByGenreAndArtist(genre, artist));
+        Q_EMIT allAlbumsData(d->queryDatabase()->allAlbumsDataByGenreAndArtist(genre, artist));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromGenreAndAuthor(genre, artist));
+        Q_EMIT allTracksData(d->queryDatabase()->tracksDataFromGenreAndAuthor(genre, artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -254,10 +279,10 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
     {
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
-        Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+        Q_EMIT allTrackData(d->queryDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+        Q_EMIT allRadioData(d->queryDatabase()->radioDataFromDatabaseId(databaseId));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -284,9 +309,9 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
     {
-        auto databaseId = d->mDatabase->trackIdFromFileName(url);
+        auto databaseId = d->queryDatabase()->trackIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+            Q_EMIT allTrackData(d->queryDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
             Q_EMIT allTrackData(result);
@@ -295,9 +320,9 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     }
     case ElisaUtils::Radio:
     {
-        auto databaseId = d->mDatabase->radioIdFromFileName(url);
+        auto databaseId = d->queryDatabase()->radioIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+            Q_EMIT allRadioData(d->queryDatabase()->radioDataFromDatabaseId(databaseId));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
             Q_EMIT allRadioData(result);
@@ -327,7 +352,8 @@ void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataT
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->recentlyPlayedTracksData(50));
+        d->flushPlayStatistics();
+        Q_EMIT allTracksData(d->queryDatabase()->recentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -354,7 +380,8 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->frequentlyPlayedTracksData(50));
+        d->flushPlayStatistics();
+        Q_EMIT allTracksData(d->queryDatabase()->frequentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -370,6 +397,15 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     }
 }
 
+void ModelDataLoader::loadDataMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText)
+{
+    if (!d->mDatabase) {
+        return;
+    }
+
+    Q_EMIT allDataMatchingSearch(searchText, d->queryDatabase()->databaseIdsMatchingSearch(dataType, searchText));
+}
+
 void ModelDataLoader::databaseTracksAdded(const ListTrackDataType &newData)
 {
     switch(d->mFilterType) {
@@ -405,7 +441,7 @@ void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
     {
         auto filteredData = newData;
         auto new_end = std::remove_if(filteredData.begin(), filteredData.end(),
-                                      [&](const auto &oneArtist){return !d->mDatabase->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
+                                      [&](const auto &oneArtist){return !d->queryDatabase()->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
         filteredData.erase(new_end, filteredData.end());
 
         Q_EMIT artistsAdded(filteredData);
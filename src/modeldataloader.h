@@ -43,6 +43,12 @@ public:
 
     void setDatabase(DatabaseInterface *database);
 
+    /**
+     * Use a read-only database living in the thread of this loader for all queries.
+     * Change notifications and modifications still go through the database given to setDatabase.
+     */
+    void setReadOnlyDatabase(DatabaseInterface *database);
+
 Q_SIGNALS:
 
     void allAlbumsData(const ModelDataLoader::ListAlbumDataType &allData);
@@ -91,6 +97,8 @@ Q_SIGNALS:
 
     void clearedDatabase();
 
+    void allDataMatchingSearch(const QString &searchText, const QList<qulonglong> &databaseIds);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
@@ -116,6 +124,8 @@ public Q_SLOTS:
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void loadDataMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
     void updateFileMetaData(const DataTypes::TrackDataType &trackDataType, const QUrl &url);
 
     void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
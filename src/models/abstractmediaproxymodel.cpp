@@ -8,6 +8,7 @@
 #include "abstractmediaproxymodel.h"
 
 #include "mediaplaylistproxymodel.h"
+#include "datamodel.h"
 
 #include <QWriteLocker>
 #include <QReadLocker>
@@ -49,11 +50,59 @@ void AbstractMediaProxyModel::setFilterText(const QString &filterText)
     mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
     mFilterExpression.optimize();
 
-    invalidate();
+    // rows are filtered again once the database has given the matching data
+    auto *dataModel = qobject_cast<DataModel*>(sourceModel());
+    if (mFilterText.isEmpty() || !dataModel || !dataModel->searchData(mFilterText)) {
+        mFilterDatabaseIds.reset();
+        invalidate();
+    }
 
     Q_EMIT filterTextChanged(mFilterText);
 }
 
+void AbstractMediaProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (auto *dataModel = qobject_cast<DataModel*>(this->sourceModel())) {
+        disconnect(dataModel, &DataModel::dataMatchingSearch, this, &AbstractMediaProxyModel::dataMatchingSearch);
+        disconnect(dataModel, &DataModel::rowsInserted, this, &AbstractMediaProxyModel::refreshSearch);
+        disconnect(dataModel, &DataModel::dataChanged, this, &AbstractMediaProxyModel::refreshSearch);
+    }
+
+    mFilterDatabaseIds.reset();
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    if (auto *dataModel = qobject_cast<DataModel*>(sourceModel)) {
+        connect(dataModel, &DataModel::dataMatchingSearch, this, &AbstractMediaProxyModel::dataMatchingSearch);
+        connect(dataModel, &DataModel::rowsInserted, this, &AbstractMediaProxyModel::refreshSearch);
+        connect(dataModel, &DataModel::dataChanged, this, &AbstractMediaProxyModel::refreshSearch);
+
+        refreshSearch();
+    }
+}
+
+void AbstractMediaProxyModel::dataMatchingSearch(const QString &searchText, const QList<qulonglong> &databaseIds)
+{
+    QWriteLocker writeLocker(&mDataLock);
+
+    if (searchText != mFilterText) {
+        return;
+    }
+
+    mFilterDatabaseIds = QSet<qulonglong>(databaseIds.cbegin(), databaseIds.cend());
+
+    invalidate();
+}
+
+void AbstractMediaProxyModel::refreshSearch()
+{
+    // new or modified rows may match the current filter
+    auto *dataModel = qobject_cast<DataModel*>(sourceModel());
+    if (!mFilterText.isEmpty() && dataModel) {
+        dataModel->searchData(mFilterText);
+    }
+}
+
 void AbstractMediaProxyModel::setFilterRating(int filterRating)
 {
     QWriteLocker writeLocker(&mDataLock);
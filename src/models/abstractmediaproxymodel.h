@@ -19,6 +19,9 @@
 #include <QThreadPool>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QSet>
+
+#include <optional>
 
 class MediaPlayListProxyModel;
 
@@ -57,6 +60,8 @@ public:
 
     [[nodiscard]] MediaPlayListProxyModel* playList() const;
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
 public Q_SLOTS:
 
     void setFilterText(const QString &filterText);
@@ -108,6 +113,15 @@ protected:
 
     QRegularExpression mFilterExpression;
 
+    /**
+     * database ids matching mFilterText when the source model can search its data in the database
+     * mFilterExpression is used otherwise
+     *
+     * Only the matching of the filter text is done by the database: the source model still holds
+     * every row of the view, loaded before any filter text is typed, and the rows are hidden here.
+     */
+    std::optional<QSet<qulonglong>> mFilterDatabaseIds;
+
     QReadWriteLock mDataLock;
 
     QThreadPool mThreadPool;
@@ -121,6 +135,10 @@ protected:
 
 private:
 
+    void dataMatchingSearch(const QString &searchText, const QList<qulonglong> &databaseIds);
+
+    void refreshSearch();
+
     QFuture<void> genericEnqueueToPlayList(const QModelIndex &rootIndex,
                                   ElisaUtils::PlayListEnqueueMode enqueueMode,
                                   ElisaUtils::PlayListEnqueueTriggerPlay triggerPlay);
@@ -11,6 +11,8 @@
 
 #include "models/modelLogging.h"
 
+#include <QHash>
+
 #include <algorithm>
 
 class DataModelPrivate
@@ -29,6 +31,8 @@ public:
 
     ModelDataLoader *mDataLoader = nullptr;
 
+    DatabaseInterface *mDatabase = nullptr;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ElisaUtils::FilterType mFilterType = ElisaUtils::UnknownFilter;
@@ -45,6 +49,136 @@ public:
 
     bool mIsBusy = false;
 
+    /**
+     * index from database id to index position for the data shown by this model
+     * a position is the row of the data when it was indexed: rows removed since then keep their
+     * position so that a removal does not shift the positions of the following rows
+     * rows appended after the last indexed row are indexed lazily on next lookup
+     */
+    QHash<qulonglong, int> mRowFromDatabaseId;
+
+    /**
+     * Fenwick tree counting the removed rows over the index positions
+     * the row of an indexed id is its position minus the removed positions before it
+     */
+    QList<int> mRemovedPositions;
+
+    int mRemovedRowsCount = 0;
+
+    [[nodiscard]] int dataCount() const
+    {
+        switch (mModelType)
+        {
+        case ElisaUtils::Track:
+            return mAllTrackData.size();
+        case ElisaUtils::Radio:
+            return mAllRadiosData.size();
+        case ElisaUtils::Album:
+            return mAllAlbumData.size();
+        case ElisaUtils::Artist:
+            return mAllArtistData.size();
+        case ElisaUtils::Genre:
+            return mAllGenreData.size();
+        default:
+            return 0;
+        }
+    }
+
+    [[nodiscard]] qulonglong databaseIdFromRow(int row) const
+    {
+        switch (mModelType)
+        {
+        case ElisaUtils::Track:
+            return mAllTrackData[row].databaseId();
+        case ElisaUtils::Radio:
+            return mAllRadiosData[row].databaseId();
+        case ElisaUtils::Album:
+            return mAllAlbumData[row].databaseId();
+        case ElisaUtils::Artist:
+            return mAllArtistData[row].databaseId();
+        case ElisaUtils::Genre:
+            return mAllGenreData[row].databaseId();
+        default:
+            return 0;
+        }
+    }
+
+    int rowFromDatabaseId(qulonglong id)
+    {
+        const auto rowsCount = dataCount();
+        for (auto indexedRowsCount = mRemovedPositions.size() - mRemovedRowsCount; indexedRowsCount < rowsCount; ++indexedRowsCount) {
+            mRowFromDatabaseId[databaseIdFromRow(indexedRowsCount)] = appendPosition();
+        }
+
+        const auto itPosition = mRowFromDatabaseId.constFind(id);
+        if (itPosition == mRowFromDatabaseId.constEnd()) {
+            return -1;
+        }
+
+        return *itPosition - removedRowsBefore(*itPosition);
+    }
+
+    void invalidateRowsIndex(int firstRow)
+    {
+        if (mRemovedRowsCount == 0) {
+            // entries of the dropped positions are overwritten when their rows are indexed again
+            mRemovedPositions.resize(std::min<qsizetype>(mRemovedPositions.size(), firstRow));
+        } else {
+            clearRowsIndex();
+        }
+    }
+
+    void removeFromRowsIndex(qulonglong id, int row)
+    {
+        const auto itPosition = mRowFromDatabaseId.constFind(id);
+        if (itPosition == mRowFromDatabaseId.constEnd() || row >= mRemovedPositions.size() - mRemovedRowsCount) {
+            invalidateRowsIndex(row);
+            return;
+        }
+
+        for (auto treeIndex = *itPosition + 1; treeIndex <= mRemovedPositions.size(); treeIndex += treeIndex & -treeIndex) {
+            ++mRemovedPositions[treeIndex - 1];
+        }
+        ++mRemovedRowsCount;
+        mRowFromDatabaseId.erase(itPosition);
+
+        // positions of removed rows are only reclaimed once they outnumber the remaining rows
+        if (mRemovedRowsCount > dataCount()) {
+            clearRowsIndex();
+        }
+    }
+
+    void clearRowsIndex()
+    {
+        mRowFromDatabaseId.clear();
+        mRemovedPositions.clear();
+        mRemovedRowsCount = 0;
+    }
+
+    [[nodiscard]] int removedRowsBefore(qsizetype position) const
+    {
+        auto result = 0;
+        for (auto treeIndex = position; treeIndex > 0; treeIndex -= treeIndex & -treeIndex) {
+            result += mRemovedPositions[treeIndex - 1];
+        }
+        return result;
+    }
+
+    int appendPosition()
+    {
+        const auto position = mRemovedPositions.size();
+
+        if (mRemovedRowsCount == 0) {
+            mRemovedPositions.push_back(0);
+        } else {
+            // the new node covers the positions ]treeIndex - lowest bit, treeIndex], the last one not being removed
+            const auto treeIndex = position + 1;
+            mRemovedPositions.push_back(removedRowsBefore(position) - removedRowsBefore(treeIndex - (treeIndex & -treeIndex)));
+        }
+
+        return static_cast<int>(position);
+    }
+
 };
 
 DataModel::DataModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<DataModelPrivate>())
@@ -392,6 +526,17 @@ bool DataModel::isBusy() const
     return d->mIsBusy;
 }
 
+bool DataModel::searchData(const QString &searchText)
+{
+    if (!d->mDatabase || !d->mDatabase->canSearchData(d->mModelType) || !DatabaseInterface::isSearchableText(searchText)) {
+        return false;
+    }
+
+    Q_EMIT needDataMatchingSearch(d->mModelType, searchText);
+
+    return true;
+}
+
 void DataModel::initializeByData(MusicListenersManager *manager, DatabaseInterface *database,
                                  ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                                  const DataTypes::DataType &dataFilter)
@@ -506,24 +651,19 @@ void DataModel::askModelData()
 
 int DataModel::indexFromId(qulonglong id) const
 {
-    int result;
-    DataModel::ListTrackDataType mAllData = d->mModelType == ElisaUtils::Radio ? d->mAllRadiosData: d->mAllTrackData;
-
-    for (result = 0; result < mAllData.size(); ++result) {
-        if (mAllData[result].databaseId() == id) {
-            return result;
-        }
-    }
-
-    result = -1;
-
-    return result;
+    return d->rowFromDatabaseId(id);
 }
 
 void DataModel::connectModel(DatabaseInterface *database)
 {
+    d->mDatabase = database;
     d->mDataLoader->setDatabase(database);
 
+    connect(this, &DataModel::needDataMatchingSearch,
+            d->mDataLoader, &ModelDataLoader::loadDataMatchingSearch);
+    connect(d->mDataLoader, &ModelDataLoader::allDataMatchingSearch,
+            this, &DataModel::dataMatchingSearch);
+
     connect(d->mDataLoader, &ModelDataLoader::allTracksData,
             this, &DataModel::tracksAdded);
     connect(d->mDataLoader, &ModelDataLoader::allRadiosData,
@@ -588,6 +728,7 @@ void DataModel::tracksAdded(ListTrackDataType newData)
                 if (oneTrack.discNumber() >= newTrack.discNumber() && oneTrack.trackNumber() > newTrack.trackNumber()) {
                     beginInsertRows({}, trackIndex, trackIndex);
                     d->mAllTrackData.insert(trackIndex, newTrack);
+                    d->invalidateRowsIndex(trackIndex);
                     endInsertRows();
 
                     if (d->mAllTrackData.size() == 1) {
@@ -649,6 +790,7 @@ void DataModel::radiosAdded(ListRadioDataType newData)
                 if (oneTrack.trackNumber() > newTrack.trackNumber()) {
                     beginInsertRows({}, trackIndex, trackIndex);
                     d->mAllRadiosData.insert(trackIndex, newTrack);
+                    d->invalidateRowsIndex(trackIndex);
                     endInsertRows();
 
                     if (d->mAllRadiosData.size() == 1) {
@@ -691,35 +833,18 @@ void DataModel::trackModified(const TrackDataType &modifiedTrack)
         return;
     }
 
-    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
-        if (modifiedTrack.album() != d->mAlbumTitle) {
-            return;
-        }
-
-        auto trackIndex = indexFromId(modifiedTrack.databaseId());
-
-        if (trackIndex == -1) {
-            return;
-        }
-
-        d->mAllTrackData[trackIndex] = modifiedTrack;
-        Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
-    } else {
-        auto itTrack = std::find_if(d->mAllTrackData.begin(), d->mAllTrackData.end(),
-                                    [modifiedTrack](auto track) {
-            return track.databaseId() == modifiedTrack.databaseId();
-        });
-
-        if (itTrack == d->mAllTrackData.end()) {
-            return;
-        }
-
-        auto position = itTrack - d->mAllTrackData.begin();
+    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty() && modifiedTrack.album() != d->mAlbumTitle) {
+        return;
+    }
 
-        d->mAllTrackData[position] = modifiedTrack;
+    auto trackIndex = indexFromId(modifiedTrack.databaseId());
 
-        Q_EMIT dataChanged(index(position, 0), index(position, 0));
+    if (trackIndex == -1) {
+        return;
     }
+
+    d->mAllTrackData[trackIndex] = modifiedTrack;
+    Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
 }
 
 void DataModel::radioModified(const TrackDataType &modifiedRadio)
@@ -744,30 +869,16 @@ void DataModel::trackRemoved(qulonglong removedTrackId)
         return;
     }
 
-    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
-        auto trackIndex = indexFromId(removedTrackId);
-
-        if (trackIndex == -1) {
-            return;
-        }
-
-        beginRemoveRows({}, trackIndex, trackIndex);
-        d->mAllTrackData.removeAt(trackIndex);
-        endRemoveRows();
-    } else {
-        const auto itTrack = std::find_if(d->mAllTrackData.cbegin(), d->mAllTrackData.cend(),
-                                         [removedTrackId](auto track) {return track.databaseId() == removedTrackId;});
-
-        if (itTrack == d->mAllTrackData.cend()) {
-            return;
-        }
+    auto trackIndex = indexFromId(removedTrackId);
 
-        auto position = itTrack - d->mAllTrackData.cbegin();
-
-        beginRemoveRows({}, position, position);
-        d->mAllTrackData.erase(itTrack);
-        endRemoveRows();
+    if (trackIndex == -1) {
+        return;
     }
+
+    beginRemoveRows({}, trackIndex, trackIndex);
+    d->mAllTrackData.removeAt(trackIndex);
+    d->removeFromRowsIndex(removedTrackId, trackIndex);
+    endRemoveRows();
 }
 
 void DataModel::radioRemoved(qulonglong removedRadioId)
@@ -776,18 +887,15 @@ void DataModel::radioRemoved(qulonglong removedRadioId)
         return;
     }
 
+    auto radioIndex = indexFromId(removedRadioId);
 
-    const auto itRadio = std::find_if(d->mAllRadiosData.cbegin(), d->mAllRadiosData.cend(),
-                                      [removedRadioId](auto track) {return track.databaseId() == removedRadioId;});
-
-    if (itRadio == d->mAllRadiosData.cend()) {
+    if (radioIndex == -1) {
         return;
     }
 
-    auto position = itRadio - d->mAllRadiosData.cbegin();
-
-    beginRemoveRows({}, position, position);
-    d->mAllRadiosData.erase(itRadio);
+    beginRemoveRows({}, radioIndex, radioIndex);
+    d->mAllRadiosData.removeAt(radioIndex);
+    d->removeFromRowsIndex(removedRadioId, radioIndex);
     endRemoveRows();
 }
 
@@ -810,6 +918,7 @@ void DataModel::removeRadios()
 
     beginRemoveRows({}, 0, d->mAllRadiosData.size());
     d->mAllRadiosData.clear();
+    d->clearRowsIndex();
     endRemoveRows();
 }
 
@@ -842,19 +951,16 @@ void DataModel::genreRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    const auto removedDataIterator = std::find_if(d->mAllGenreData.cbegin(), d->mAllGenreData.cend(), [removedDatabaseId](const auto &genre) {
-        return genre.databaseId() == removedDatabaseId;
-    });
+    const auto dataIndex = indexFromId(removedDatabaseId);
 
-    if (removedDataIterator == d->mAllGenreData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllGenreData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllGenreData.erase(removedDataIterator);
+    d->mAllGenreData.removeAt(dataIndex);
+    d->removeFromRowsIndex(removedDatabaseId, dataIndex);
 
     endRemoveRows();
 }
@@ -888,18 +994,16 @@ void DataModel::artistRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    const auto removedDataIterator = std::find_if(d->mAllArtistData.cbegin(), d->mAllArtistData.cend(),
-                                                  [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
+    const auto dataIndex = indexFromId(removedDatabaseId);
 
-    if (removedDataIterator == d->mAllArtistData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllArtistData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllArtistData.erase(removedDataIterator);
+    d->mAllArtistData.removeAt(dataIndex);
+    d->removeFromRowsIndex(removedDatabaseId, dataIndex);
 
     endRemoveRows();
 }
@@ -933,20 +1037,16 @@ void DataModel::albumRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    auto removedDataIterator = d->mAllAlbumData.cend();
+    const auto dataIndex = indexFromId(removedDatabaseId);
 
-    removedDataIterator = std::find_if(d->mAllAlbumData.cbegin(), d->mAllAlbumData.cend(),
-                                       [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
-
-    if (removedDataIterator == d->mAllAlbumData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllAlbumData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllAlbumData.erase(removedDataIterator);
+    d->mAllAlbumData.removeAt(dataIndex);
+    d->removeFromRowsIndex(removedDatabaseId, dataIndex);
 
     endRemoveRows();
 }
@@ -957,17 +1057,12 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
         return;
     }
 
-    auto modifiedAlbumIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
-                                              [modifiedAlbum](auto album) {
-        return album.databaseId() == modifiedAlbum.databaseId();
-    });
+    const auto albumIndex = indexFromId(modifiedAlbum.databaseId());
 
-    if (modifiedAlbumIterator == d->mAllAlbumData.end()) {
+    if (albumIndex == -1) {
         return;
     }
 
-    auto albumIndex = modifiedAlbumIterator - d->mAllAlbumData.begin();
-
     Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
 }
 
@@ -994,6 +1089,7 @@ void DataModel::cleanedDatabase()
     d->mAllGenreData.clear();
     d->mAllTrackData.clear();
     d->mAllArtistData.clear();
+    d->clearRowsIndex();
     endResetModel();
 }
 
@@ -83,6 +83,13 @@ public:
 
     [[nodiscard]] bool isBusy() const;
 
+    /**
+     * look for the data matching searchText in the full text index of the database
+     * the result is given by dataMatchingSearch
+     * @return false if this kind of data cannot be searched in the database or searchText has no word to search
+     */
+    bool searchData(const QString &searchText);
+
 Q_SIGNALS:
 
     void titleChanged();
@@ -104,6 +111,10 @@ Q_SIGNALS:
 
     void needFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void needDataMatchingSearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText);
+
+    void dataMatchingSearch(const QString &searchText, const QList<qulonglong> &databaseIds);
+
     void isBusyChanged();
 
 public Q_SLOTS:
@@ -25,10 +25,6 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
 
     auto currentIndex = sourceModel()->index(source_row, 0, source_parent);
 
-    const auto &mainValue = sourceModel()->data(currentIndex, Qt::DisplayRole).toString();
-    const auto &artistValue = sourceModel()->data(currentIndex, DataTypes::ArtistRole).toString();
-    const auto &albumValue = sourceModel()->data(currentIndex, DataTypes::AlbumRole).toString();
-    const auto &allArtistsValue = sourceModel()->data(currentIndex, DataTypes::AllArtistsRole).toStringList();
     bool collectionMaximumRatingValueIsValid = false;
     const auto collectionMaximumRatingValue = sourceModel()->data(currentIndex, DataTypes::HighestTrackRating).toInt(&collectionMaximumRatingValueIsValid);
     bool maximumRatingValueIsValid = false;
@@ -43,6 +39,16 @@ bool GridViewProxyModel::filterAcceptsRow(int source_row, const QModelIndex &sou
         return result;
     }
 
+    if (mFilterDatabaseIds) {
+        result = mFilterDatabaseIds->contains(sourceModel()->data(currentIndex, DataTypes::DatabaseIdRole).toULongLong());
+        return result;
+    }
+
+    const auto &mainValue = sourceModel()->data(currentIndex, Qt::DisplayRole).toString();
+    const auto &artistValue = sourceModel()->data(currentIndex, DataTypes::ArtistRole).toString();
+    const auto &albumValue = sourceModel()->data(currentIndex, DataTypes::AlbumRole).toString();
+    const auto &allArtistsValue = sourceModel()->data(currentIndex, DataTypes::AllArtistsRole).toStringList();
+
     if (mFilterExpression.match(mainValue.normalized(QString::NormalizationForm_KC)).hasMatch()) {
         result = true;
         return result;
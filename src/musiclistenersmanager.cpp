@@ -36,6 +36,17 @@
 #include <QFileSystemWatcher>
 
 #include <list>
+#include <vector>
+
+class ReadOnlyDatabase
+{
+public:
+
+    QThread mThread;
+
+    DatabaseInterface mDatabase;
+
+};
 
 class MusicListenersManagerPrivate
 {
@@ -57,6 +68,12 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    QString mDatabaseFileName;
+
+    std::vector<std::unique_ptr<ReadOnlyDatabase>> mReadOnlyDatabases;
+
+    std::size_t mNextReadOnlyDatabase = 0;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -112,6 +129,8 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
         QDir myDataDirectory;
         myDataDirectory.mkpath(localDataPaths.first());
         databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
+        d->mDatabaseFileName = databaseFileName;
+        d->mFileListener.setScanManifestFileName(localDataPaths.first() + QStringLiteral("/elisaScanManifest.dat"));
     }
 
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
@@ -122,6 +141,8 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
 
 MusicListenersManager::~MusicListenersManager()
 {
+    stopReadOnlyDatabases();
+
     d->mListenerThread.quit();
     d->mListenerThread.wait();
 
@@ -138,10 +159,13 @@ void MusicListenersManager::subscribeForTracks(MediaPlayList *client)
 {
     createTracksListener();
     connect(d->mTracksListener.get(), &TracksListener::trackHasChanged, client, &MediaPlayList::trackChanged);
+    connect(d->mTracksListener.get(), &TracksListener::tracksHaveChanged, client, &MediaPlayList::tracksChanged);
     connect(d->mTracksListener.get(), &TracksListener::trackHasBeenRemoved, client, &MediaPlayList::trackRemoved);
     connect(d->mTracksListener.get(), &TracksListener::tracksListAdded, client, &MediaPlayList::tracksListAdded);
     connect(client, &MediaPlayList::newEntryInList, d->mTracksListener.get(), &TracksListener::newEntryInList);
     connect(client, &MediaPlayList::newUrlInList, d->mTracksListener.get(), &TracksListener::newUrlInList);
+    connect(client, &MediaPlayList::newUrlsInList, d->mTracksListener.get(), &TracksListener::newUrlsInList);
+    connect(client, &MediaPlayList::newTracksInList, d->mTracksListener.get(), &TracksListener::newTracksInList);
     connect(client, &MediaPlayList::newTrackByNameInList, d->mTracksListener.get(), &TracksListener::trackByNameInList);
 }
 
@@ -196,6 +220,8 @@ auto MusicListenersManager::initializeRootPath()
 
 void MusicListenersManager::databaseReady()
 {
+    startReadOnlyDatabases();
+
     auto initialRootPath = Elisa::ElisaConfiguration::rootPath();
     if (initialRootPath.isEmpty()) {
         initializeRootPath();
@@ -212,6 +238,8 @@ void MusicListenersManager::applicationAboutToQuit()
 
     Q_EMIT applicationIsTerminating();
 
+    stopReadOnlyDatabases();
+
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
@@ -268,7 +296,45 @@ void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entr
 
 void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
 {
-    dataLoader->moveToThread(&d->mDatabaseThread);
+    if (d->mReadOnlyDatabases.empty()) {
+        dataLoader->moveToThread(&d->mDatabaseThread);
+        return;
+    }
+
+    auto &readOnlyDatabase = d->mReadOnlyDatabases[d->mNextReadOnlyDatabase];
+    d->mNextReadOnlyDatabase = (d->mNextReadOnlyDatabase + 1) % d->mReadOnlyDatabases.size();
+
+    dataLoader->moveToThread(&readOnlyDatabase->mThread);
+    dataLoader->setReadOnlyDatabase(&readOnlyDatabase->mDatabase);
+}
+
+void MusicListenersManager::startReadOnlyDatabases()
+{
+    // an in-memory database cannot be shared between connections
+    if (d->mDatabaseFileName.isEmpty() || !d->mReadOnlyDatabases.empty()) {
+        return;
+    }
+
+    const auto readOnlyDatabasesCount = qBound(1, QThread::idealThreadCount() / 2, 4);
+    for (int i = 0; i < readOnlyDatabasesCount; ++i) {
+        auto readOnlyDatabase = std::make_unique<ReadOnlyDatabase>();
+
+        readOnlyDatabase->mThread.start();
+        readOnlyDatabase->mDatabase.moveToThread(&readOnlyDatabase->mThread);
+
+        QMetaObject::invokeMethod(&readOnlyDatabase->mDatabase, "initReadOnly", Qt::QueuedConnection,
+                                  Q_ARG(QString, QStringLiteral("views%1").arg(i)), Q_ARG(QString, d->mDatabaseFileName));
+
+        d->mReadOnlyDatabases.push_back(std::move(readOnlyDatabase));
+    }
+}
+
+void MusicListenersManager::stopReadOnlyDatabases()
+{
+    for (const auto &readOnlyDatabase : d->mReadOnlyDatabases) {
+        readOnlyDatabase->mThread.exit();
+        readOnlyDatabase->mThread.wait();
+    }
 }
 
 void MusicListenersManager::scanCollection(CollectionScan scantype)
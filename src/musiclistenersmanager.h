@@ -163,6 +163,10 @@ private:
 
     void startAndroidIndexing();
 
+    void startReadOnlyDatabases();
+
+    void stopReadOnlyDatabases();
+
     auto initializeRootPath();
 
     std::unique_ptr<MusicListenersManagerPrivate> d;
@@ -178,6 +178,19 @@ Kirigami.Page {
 
                     currentIndex: -1
 
+                    // entries of large play lists are resolved once they are shown
+                    function updateVisibleRows() {
+                        if (!ElisaApplication.mediaPlayListProxyModel) {
+                            return
+                        }
+                        const lastIndex = indexAt(0, contentY + height - 1)
+                        ElisaApplication.mediaPlayListProxyModel.setVisibleRows(Math.max(indexAt(0, contentY), 0), lastIndex > -1 ? lastIndex : count - 1)
+                    }
+
+                    onContentYChanged: updateVisibleRows()
+                    onHeightChanged: updateVisibleRows()
+                    onCountChanged: updateVisibleRows()
+
                     onActiveFocusChanged: {
                         if (activeFocus) {
                             // callLater to make sure this is a Tab focusing
@@ -357,6 +370,19 @@ Kirigami.Page {
                     model: ElisaApplication.mediaPlayListProxyModel
                     activeFocusOnTab: count > 0
 
+                    // entries of large play lists are resolved once they are shown
+                    function updateVisibleRows() {
+                        if (!ElisaApplication.mediaPlayListProxyModel) {
+                            return
+                        }
+                        const lastIndex = indexAt(0, contentY + height - 1)
+                        ElisaApplication.mediaPlayListProxyModel.setVisibleRows(Math.max(indexAt(0, contentY), 0), lastIndex > -1 ? lastIndex : count - 1)
+                    }
+
+                    onContentYChanged: updateVisibleRows()
+                    onHeightChanged: updateVisibleRows()
+                    onCountChanged: updateVisibleRows()
+
                     moveDisplaced: Transition {
                         YAnimator {
                             duration: Kirigami.Units.longDuration
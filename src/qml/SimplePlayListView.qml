@@ -41,6 +41,19 @@ ScrollView {
         activeFocusOnTab: true
         keyNavigationEnabled: true
 
+        // entries of large play lists are resolved once they are shown
+        function updateVisibleRows() {
+            if (!ElisaApplication.mediaPlayListProxyModel) {
+                return
+            }
+            const lastIndex = indexAt(0, contentY + height - 1)
+            ElisaApplication.mediaPlayListProxyModel.setVisibleRows(Math.max(indexAt(0, contentY), 0), lastIndex > -1 ? lastIndex : count - 1)
+        }
+
+        onContentYChanged: updateVisibleRows()
+        onHeightChanged: updateVisibleRows()
+        onCountChanged: updateVisibleRows()
+
         // position the view at the playing index
         Component.onCompleted: currentIndex = nextIndex
         Connections {
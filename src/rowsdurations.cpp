@@ -0,0 +1,231 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "rowsdurations.h"
+
+void RowsDurations::clear()
+{
+    mEntries.clear();
+    mFreeEntries.clear();
+    mRoot = -1;
+}
+
+int RowsDurations::size() const
+{
+    return treeSize(mRoot);
+}
+
+void RowsDurations::insertRows(int first, const QList<qint64> &durations)
+{
+    auto newRows = int{-1};
+    for (const auto oneDuration : durations) {
+        newRows = merge(newRows, newEntry(oneDuration));
+    }
+
+    auto left = int{-1};
+    auto right = int{-1};
+    split(mRoot, first, left, right);
+    mRoot = merge(merge(left, newRows), right);
+}
+
+void RowsDurations::removeRows(int first, int count)
+{
+    auto left = int{-1};
+    auto middle = int{-1};
+    auto right = int{-1};
+    split(mRoot, first, left, middle);
+    split(middle, count, middle, right);
+    mRoot = merge(left, right);
+
+    releaseTree(middle);
+}
+
+void RowsDurations::moveRows(int first, int count, int destination)
+{
+    auto left = int{-1};
+    auto moved = int{-1};
+    auto right = int{-1};
+    split(mRoot, first, left, moved);
+    split(moved, count, moved, right);
+
+    split(merge(left, right), destination, left, right);
+    mRoot = merge(merge(left, moved), right);
+}
+
+void RowsDurations::setDuration(int row, qint64 duration)
+{
+    if (row < 0 || row >= size()) {
+        return;
+    }
+
+    const auto delta = duration - this->duration(row);
+
+    // every node on the path to the row sums its duration
+    auto entry = mRoot;
+    while (entry != -1) {
+        auto &oneEntry = mEntries[entry];
+        oneEntry.mDurationsSum += delta;
+
+        const auto leftSize = treeSize(oneEntry.mLeft);
+        if (row < leftSize) {
+            entry = oneEntry.mLeft;
+        } else if (row == leftSize) {
+            oneEntry.mDuration = duration;
+            return;
+        } else {
+            row -= leftSize + 1;
+            entry = oneEntry.mRight;
+        }
+    }
+}
+
+qint64 RowsDurations::duration(int row) const
+{
+    auto entry = mRoot;
+    while (entry != -1) {
+        const auto &oneEntry = mEntries[entry];
+        const auto leftSize = treeSize(oneEntry.mLeft);
+        if (row < leftSize) {
+            entry = oneEntry.mLeft;
+        } else if (row == leftSize) {
+            return oneEntry.mDuration;
+        } else {
+            row -= leftSize + 1;
+            entry = oneEntry.mRight;
+        }
+    }
+
+    return 0;
+}
+
+qint64 RowsDurations::durationOfFirstRows(int rowsCount) const
+{
+    auto result = qint64{0};
+
+    auto entry = mRoot;
+    while (entry != -1 && rowsCount > 0) {
+        const auto &oneEntry = mEntries[entry];
+        const auto leftSize = treeSize(oneEntry.mLeft);
+        if (rowsCount <= leftSize) {
+            entry = oneEntry.mLeft;
+        } else {
+            result += treeDuration(oneEntry.mLeft) + oneEntry.mDuration;
+            rowsCount -= leftSize + 1;
+            entry = oneEntry.mRight;
+        }
+    }
+
+    return result;
+}
+
+qint64 RowsDurations::totalDuration() const
+{
+    return treeDuration(mRoot);
+}
+
+int RowsDurations::newEntry(qint64 duration)
+{
+    auto entry = int{};
+    if (!mFreeEntries.empty()) {
+        entry = mFreeEntries.back();
+        mFreeEntries.pop_back();
+        mEntries[entry] = {};
+    } else {
+        entry = static_cast<int>(mEntries.size());
+        mEntries.emplace_back();
+    }
+
+    auto &oneEntry = mEntries[entry];
+    oneEntry.mPriority = (mPrioritySeed = mPrioritySeed * 1664525u + 1013904223u);
+    oneEntry.mDuration = duration;
+    oneEntry.mDurationsSum = duration;
+
+    return entry;
+}
+
+void RowsDurations::releaseTree(int root)
+{
+    if (root == -1) {
+        return;
+    }
+
+    auto pendingEntries = std::vector<int>{root};
+    while (!pendingEntries.empty()) {
+        const auto entry = pendingEntries.back();
+        pendingEntries.pop_back();
+
+        if (mEntries[entry].mLeft != -1) {
+            pendingEntries.push_back(mEntries[entry].mLeft);
+        }
+        if (mEntries[entry].mRight != -1) {
+            pendingEntries.push_back(mEntries[entry].mRight);
+        }
+
+        mFreeEntries.push_back(entry);
+    }
+}
+
+int RowsDurations::treeSize(int entry) const
+{
+    return entry == -1 ? 0 : mEntries[entry].mSize;
+}
+
+qint64 RowsDurations::treeDuration(int entry) const
+{
+    return entry == -1 ? 0 : mEntries[entry].mDurationsSum;
+}
+
+void RowsDurations::updateNode(int entry)
+{
+    auto &oneEntry = mEntries[entry];
+    oneEntry.mSize = 1 + treeSize(oneEntry.mLeft) + treeSize(oneEntry.mRight);
+    oneEntry.mDurationsSum = oneEntry.mDuration + treeDuration(oneEntry.mLeft) + treeDuration(oneEntry.mRight);
+}
+
+void RowsDurations::split(int root, int position, int &left, int &right)
+{
+    if (root == -1) {
+        left = -1;
+        right = -1;
+        return;
+    }
+
+    if (treeSize(mEntries[root].mLeft) < position) {
+        auto splitRight = int{-1};
+        split(mEntries[root].mRight, position - treeSize(mEntries[root].mLeft) - 1, splitRight, right);
+        mEntries[root].mRight = splitRight;
+        left = root;
+    } else {
+        auto splitLeft = int{-1};
+        split(mEntries[root].mLeft, position, left, splitLeft);
+        mEntries[root].mLeft = splitLeft;
+        right = root;
+    }
+
+    updateNode(root);
+}
+
+int RowsDurations::merge(int left, int right)
+{
+    if (left == -1) {
+        return right;
+    }
+    if (right == -1) {
+        return left;
+    }
+
+    if (mEntries[left].mPriority > mEntries[right].mPriority) {
+        const auto mergedRight = merge(mEntries[left].mRight, right);
+        mEntries[left].mRight = mergedRight;
+        updateNode(left);
+        return left;
+    }
+
+    const auto mergedLeft = merge(left, mEntries[right].mLeft);
+    mEntries[right].mLeft = mergedLeft;
+    updateNode(right);
+    return right;
+}
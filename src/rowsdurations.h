@@ -0,0 +1,96 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef ROWSDURATIONS_H
+#define ROWSDURATIONS_H
+
+#include "elisaLib_export.h"
+
+#include <QList>
+
+#include <vector>
+
+/**
+ * Durations of the rows of a play list and their running totals.
+ *
+ * The durations are kept in an order statistic tree (implicit treap) where each node also
+ * sums the durations of its subtree. Inserting, removing or moving k rows anywhere, changing
+ * one duration and getting the total duration of the first rows are O(k log n).
+ */
+class ELISALIB_EXPORT RowsDurations
+{
+public:
+
+    void clear();
+
+    [[nodiscard]] int size() const;
+
+    /**
+     * insert the durations of new rows starting at first, the following rows are shifted
+     */
+    void insertRows(int first, const QList<qint64> &durations);
+
+    void removeRows(int first, int count);
+
+    /**
+     * move count rows starting at first so that the first one ends up at row destination
+     * destination is counted once the moved rows have been taken out
+     */
+    void moveRows(int first, int count, int destination);
+
+    void setDuration(int row, qint64 duration);
+
+    [[nodiscard]] qint64 duration(int row) const;
+
+    /**
+     * sum of the durations of the rowsCount first rows
+     */
+    [[nodiscard]] qint64 durationOfFirstRows(int rowsCount) const;
+
+    [[nodiscard]] qint64 totalDuration() const;
+
+private:
+
+    struct Entry
+    {
+        int mLeft = -1;
+
+        int mRight = -1;
+
+        int mSize = 1;
+
+        quint32 mPriority = 0;
+
+        qint64 mDuration = 0;
+
+        qint64 mDurationsSum = 0;
+    };
+
+    [[nodiscard]] int newEntry(qint64 duration);
+
+    void releaseTree(int root);
+
+    [[nodiscard]] int treeSize(int entry) const;
+
+    [[nodiscard]] qint64 treeDuration(int entry) const;
+
+    void updateNode(int entry);
+
+    void split(int root, int position, int &left, int &right);
+
+    [[nodiscard]] int merge(int left, int right);
+
+    std::vector<Entry> mEntries;
+
+    std::vector<int> mFreeEntries;
+
+    int mRoot = -1;
+
+    quint32 mPrioritySeed = 0x9e3779b9;
+
+};
+
+#endif // ROWSDURATIONS_H
@@ -0,0 +1,290 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "shuffledrowsmapping.h"
+
+void ShuffledRowsMapping::assign(const QList<int> &sourceRows)
+{
+    clear();
+
+    mEntries.resize(sourceRows.size());
+    for (int i = 0; i < sourceRows.size(); ++i) {
+        mEntries[i].mPriority = (mPrioritySeed = mPrioritySeed * 1664525u + 1013904223u);
+        mEntries[i].mIsPlaced = true;
+    }
+
+    // the entry of source row n is entry n
+    for (int i = 0; i < sourceRows.size(); ++i) {
+        mSourceRoot = merge(mSourceRoot, i, &Entry::mSourceLinks);
+    }
+    for (const auto oneSourceRow : sourceRows) {
+        mProxyRoot = merge(mProxyRoot, oneSourceRow, &Entry::mProxyLinks);
+    }
+}
+
+void ShuffledRowsMapping::clear()
+{
+    mEntries.clear();
+    mFreeEntries.clear();
+    mProxyRoot = -1;
+    mSourceRoot = -1;
+}
+
+bool ShuffledRowsMapping::isEmpty() const
+{
+    return mProxyRoot == -1;
+}
+
+int ShuffledRowsMapping::size() const
+{
+    return treeSize(mProxyRoot, &Entry::mProxyLinks);
+}
+
+int ShuffledRowsMapping::sourceRow(int proxyRow) const
+{
+    const auto entry = select(mProxyRoot, proxyRow, &Entry::mProxyLinks);
+    if (entry == -1) {
+        return -1;
+    }
+
+    return rank(entry, &Entry::mSourceLinks);
+}
+
+int ShuffledRowsMapping::proxyRow(int sourceRow) const
+{
+    const auto entry = select(mSourceRoot, sourceRow, &Entry::mSourceLinks);
+    if (entry == -1 || !mEntries[entry].mIsPlaced) {
+        return -1;
+    }
+
+    return rank(entry, &Entry::mProxyLinks);
+}
+
+void ShuffledRowsMapping::insertSourceRows(int first, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        insertInTree(mSourceRoot, first + i, newEntry(), &Entry::mSourceLinks);
+    }
+}
+
+void ShuffledRowsMapping::placeSourceRow(int sourceRow, int proxyRow)
+{
+    const auto entry = select(mSourceRoot, sourceRow, &Entry::mSourceLinks);
+    if (entry == -1 || mEntries[entry].mIsPlaced) {
+        return;
+    }
+
+    insertInTree(mProxyRoot, proxyRow, entry, &Entry::mProxyLinks);
+    mEntries[entry].mIsPlaced = true;
+}
+
+void ShuffledRowsMapping::removeSourceRow(int sourceRow)
+{
+    const auto entry = select(mSourceRoot, sourceRow, &Entry::mSourceLinks);
+    if (entry == -1) {
+        return;
+    }
+
+    if (mEntries[entry].mIsPlaced) {
+        removeFromTree(mProxyRoot, entry, &Entry::mProxyLinks);
+    }
+    removeFromTree(mSourceRoot, entry, &Entry::mSourceLinks);
+
+    mFreeEntries.push_back(entry);
+}
+
+void ShuffledRowsMapping::moveProxyRow(int from, int to)
+{
+    const auto entry = select(mProxyRoot, from, &Entry::mProxyLinks);
+    if (entry == -1) {
+        return;
+    }
+
+    removeFromTree(mProxyRoot, entry, &Entry::mProxyLinks);
+    insertInTree(mProxyRoot, to, entry, &Entry::mProxyLinks);
+}
+
+QList<int> ShuffledRowsMapping::sourceRows() const
+{
+    QList<int> result;
+    result.reserve(size());
+
+    // in-order traversal of the proxy tree
+    auto entry = mProxyRoot;
+    auto previousEntry = -1;
+    while (entry != -1) {
+        const auto &links = mEntries[entry].mProxyLinks;
+        if (previousEntry == links.mParent) {
+            if (links.mLeft != -1) {
+                previousEntry = entry;
+                entry = links.mLeft;
+                continue;
+            }
+            previousEntry = -1;
+        }
+        if (previousEntry == links.mLeft) {
+            result.push_back(rank(entry, &Entry::mSourceLinks));
+            if (links.mRight != -1) {
+                previousEntry = entry;
+                entry = links.mRight;
+                continue;
+            }
+        }
+        previousEntry = entry;
+        entry = links.mParent;
+    }
+
+    return result;
+}
+
+int ShuffledRowsMapping::newEntry()
+{
+    auto entry = int{};
+    if (!mFreeEntries.empty()) {
+        entry = mFreeEntries.back();
+        mFreeEntries.pop_back();
+        mEntries[entry] = {};
+    } else {
+        entry = static_cast<int>(mEntries.size());
+        mEntries.emplace_back();
+    }
+
+    mEntries[entry].mPriority = (mPrioritySeed = mPrioritySeed * 1664525u + 1013904223u);
+
+    return entry;
+}
+
+int ShuffledRowsMapping::treeSize(int entry, Links links) const
+{
+    return entry == -1 ? 0 : (mEntries[entry].*links).mSize;
+}
+
+void ShuffledRowsMapping::updateNode(int entry, Links links)
+{
+    auto &nodeLinks = mEntries[entry].*links;
+    nodeLinks.mSize = 1 + treeSize(nodeLinks.mLeft, links) + treeSize(nodeLinks.mRight, links);
+    if (nodeLinks.mLeft != -1) {
+        (mEntries[nodeLinks.mLeft].*links).mParent = entry;
+    }
+    if (nodeLinks.mRight != -1) {
+        (mEntries[nodeLinks.mRight].*links).mParent = entry;
+    }
+}
+
+int ShuffledRowsMapping::rank(int entry, Links links) const
+{
+    auto result = treeSize((mEntries[entry].*links).mLeft, links);
+    auto parent = (mEntries[entry].*links).mParent;
+    while (parent != -1) {
+        const auto &parentLinks = mEntries[parent].*links;
+        if (parentLinks.mRight == entry) {
+            result += treeSize(parentLinks.mLeft, links) + 1;
+        }
+        entry = parent;
+        parent = parentLinks.mParent;
+    }
+
+    return result;
+}
+
+int ShuffledRowsMapping::select(int root, int position, Links links) const
+{
+    if (position < 0 || position >= treeSize(root, links)) {
+        return -1;
+    }
+
+    auto entry = root;
+    while (entry != -1) {
+        const auto &entryLinks = mEntries[entry].*links;
+        const auto leftSize = treeSize(entryLinks.mLeft, links);
+        if (position < leftSize) {
+            entry = entryLinks.mLeft;
+        } else if (position == leftSize) {
+            return entry;
+        } else {
+            position -= leftSize + 1;
+            entry = entryLinks.mRight;
+        }
+    }
+
+    return -1;
+}
+
+void ShuffledRowsMapping::split(int root, int position, int &left, int &right, Links links)
+{
+    if (root == -1) {
+        left = -1;
+        right = -1;
+        return;
+    }
+
+    auto &rootLinks = mEntries[root].*links;
+    if (treeSize(rootLinks.mLeft, links) < position) {
+        auto splitRight = int{-1};
+        split(rootLinks.mRight, position - treeSize(rootLinks.mLeft, links) - 1, splitRight, right, links);
+        (mEntries[root].*links).mRight = splitRight;
+        left = root;
+    } else {
+        auto splitLeft = int{-1};
+        split(rootLinks.mLeft, position, left, splitLeft, links);
+        (mEntries[root].*links).mLeft = splitLeft;
+        right = root;
+    }
+
+    updateNode(root, links);
+    if (left != -1) {
+        (mEntries[left].*links).mParent = -1;
+    }
+    if (right != -1) {
+        (mEntries[right].*links).mParent = -1;
+    }
+}
+
+int ShuffledRowsMapping::merge(int left, int right, Links links)
+{
+    if (left == -1) {
+        return right;
+    }
+    if (right == -1) {
+        return left;
+    }
+
+    if (mEntries[left].mPriority > mEntries[right].mPriority) {
+        const auto mergedRight = merge((mEntries[left].*links).mRight, right, links);
+        (mEntries[left].*links).mRight = mergedRight;
+        updateNode(left, links);
+        (mEntries[left].*links).mParent = -1;
+        return left;
+    }
+
+    const auto mergedLeft = merge(left, (mEntries[right].*links).mLeft, links);
+    (mEntries[right].*links).mLeft = mergedLeft;
+    updateNode(right, links);
+    (mEntries[right].*links).mParent = -1;
+    return right;
+}
+
+void ShuffledRowsMapping::insertInTree(int &root, int position, int entry, Links links)
+{
+    mEntries[entry].*links = {};
+
+    auto left = int{-1};
+    auto right = int{-1};
+    split(root, position, left, right, links);
+    root = merge(merge(left, entry, links), right, links);
+}
+
+void ShuffledRowsMapping::removeFromTree(int &root, int entry, Links links)
+{
+    const auto position = rank(entry, links);
+
+    auto left = int{-1};
+    auto middle = int{-1};
+    auto right = int{-1};
+    split(root, position, left, middle, links);
+    split(middle, 1, middle, right, links);
+    root = merge(left, right, links);
+}
@@ -0,0 +1,121 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) The Elisa Developers
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef SHUFFLEDROWSMAPPING_H
+#define SHUFFLEDROWSMAPPING_H
+
+#include "elisaLib_export.h"
+
+#include <QList>
+
+#include <vector>
+
+/**
+ * Mapping between the rows of a play list and their shuffled order.
+ *
+ * Each row is kept in two order statistic trees (implicit treaps): one in source order
+ * and one in shuffled (proxy) order. Looking up a row in either direction, inserting a row
+ * at any position or removing one are O(log n) and renumbering the following rows is implicit.
+ */
+class ELISALIB_EXPORT ShuffledRowsMapping
+{
+public:
+
+    /**
+     * replace the mapping, sourceRows lists the source row shown at each proxy row
+     */
+    void assign(const QList<int> &sourceRows);
+
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const;
+
+    /**
+     * number of rows placed in proxy order
+     */
+    [[nodiscard]] int size() const;
+
+    [[nodiscard]] int sourceRow(int proxyRow) const;
+
+    /**
+     * @return -1 if sourceRow has not been placed in proxy order
+     */
+    [[nodiscard]] int proxyRow(int sourceRow) const;
+
+    /**
+     * insert count source rows starting at first, the following source rows are shifted
+     * the new rows are not in proxy order until they are placed with placeSourceRow
+     */
+    void insertSourceRows(int first, int count);
+
+    void placeSourceRow(int sourceRow, int proxyRow);
+
+    void removeSourceRow(int sourceRow);
+
+    void moveProxyRow(int from, int to);
+
+    /**
+     * source rows in proxy order
+     */
+    [[nodiscard]] QList<int> sourceRows() const;
+
+private:
+
+    struct TreeLinks
+    {
+        int mLeft = -1;
+
+        int mRight = -1;
+
+        int mParent = -1;
+
+        int mSize = 1;
+    };
+
+    struct Entry
+    {
+        TreeLinks mProxyLinks;
+
+        TreeLinks mSourceLinks;
+
+        quint32 mPriority = 0;
+
+        bool mIsPlaced = false;
+    };
+
+    using Links = TreeLinks Entry::*;
+
+    [[nodiscard]] int newEntry();
+
+    [[nodiscard]] int treeSize(int entry, Links links) const;
+
+    void updateNode(int entry, Links links);
+
+    [[nodiscard]] int rank(int entry, Links links) const;
+
+    [[nodiscard]] int select(int root, int position, Links links) const;
+
+    void split(int root, int position, int &left, int &right, Links links);
+
+    [[nodiscard]] int merge(int left, int right, Links links);
+
+    void insertInTree(int &root, int position, int entry, Links links);
+
+    void removeFromTree(int &root, int entry, Links links);
+
+    std::vector<Entry> mEntries;
+
+    std::vector<int> mFreeEntries;
+
+    int mProxyRoot = -1;
+
+    int mSourceRoot = -1;
+
+    quint32 mPrioritySeed = 0x9e3779b9;
+
+};
+
+#endif // SHUFFLEDROWSMAPPING_H
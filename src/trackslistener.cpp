@@ -9,13 +9,47 @@
 #include "playListLogging.h"
 #include "filescanner.h"
 #include "filewriter.h"
+#include "elisautils.h"
 
 #include <QSet>
 #include <QList>
+#include <QHashFunctions>
 
 #include <array>
 #include <algorithm>
 
+namespace
+{
+
+/**
+ * track waiting to be indexed, an empty title, artist or album matches any value
+ */
+struct PendingTrackKey
+{
+    QString mTitle;
+
+    QString mArtist;
+
+    QString mAlbum;
+
+    int mTrackNumber = 0;
+
+    int mDiscNumber = 0;
+
+    friend bool operator==(const PendingTrackKey &lhs, const PendingTrackKey &rhs)
+    {
+        return lhs.mTitle == rhs.mTitle && lhs.mArtist == rhs.mArtist && lhs.mAlbum == rhs.mAlbum &&
+                lhs.mTrackNumber == rhs.mTrackNumber && lhs.mDiscNumber == rhs.mDiscNumber;
+    }
+
+    friend size_t qHash(const PendingTrackKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.mTitle, key.mArtist, key.mAlbum, key.mTrackNumber, key.mDiscNumber);
+    }
+};
+
+}
+
 class TracksListenerPrivate
 {
 public:
@@ -24,7 +58,7 @@ public:
 
     QSet<qulonglong> mRadiosByIdSet;
 
-    QList<std::tuple<QString, QString, QString, int, int>> mTracksByNameSet;
+    QSet<PendingTrackKey> mTracksByNameSet;
 
     QList<QUrl> mTracksByFileNameSet;
 
@@ -51,39 +85,26 @@ void TracksListener::tracksAdded(const ListTrackDataType &allTracks)
         }
 
         if (d->mTracksByNameSet.isEmpty()) {
-            return;
+            continue;
         }
 
-        for (auto itTrack = d->mTracksByNameSet.begin(); itTrack != d->mTracksByNameSet.end(); ) {
-            if (!std::get<0>(*itTrack).isEmpty() && std::get<0>(*itTrack) != oneTrack.title()) {
-                ++itTrack;
-                continue;
-            }
-
-            if (!std::get<1>(*itTrack).isEmpty() && std::get<1>(*itTrack) != oneTrack.artist()) {
-                ++itTrack;
-                continue;
-            }
-
-            if (!std::get<2>(*itTrack).isEmpty() && std::get<2>(*itTrack) != oneTrack.album()) {
-                ++itTrack;
-                continue;
-            }
-
-            if (std::get<3>(*itTrack) != oneTrack.trackNumber()) {
-                ++itTrack;
-                continue;
-            }
-
-            if (std::get<4>(*itTrack) != oneTrack.discNumber()) {
-                ++itTrack;
+        // a pending track can leave its title, artist or album empty: look up each combination
+        for (int wildcards = 0; wildcards < 8; ++wildcards) {
+            const auto pendingTrack = PendingTrackKey{
+                (wildcards & 1) ? QString{} : oneTrack.title(),
+                (wildcards & 2) ? QString{} : oneTrack.artist(),
+                (wildcards & 4) ? QString{} : oneTrack.album(),
+                oneTrack.trackNumber(),
+                oneTrack.discNumber(),
+            };
+
+            if (!d->mTracksByNameSet.remove(pendingTrack)) {
                 continue;
             }
 
             Q_EMIT trackHasChanged(TrackDataType(oneTrack));
 
             d->mTracksByIdSet.insert(oneTrack.databaseId());
-            itTrack = d->mTracksByNameSet.erase(itTrack);
         }
     }
 }
@@ -106,11 +127,12 @@ void TracksListener::trackByNameInList(const QVariant &title, const QVariant &ar
                                        const QVariant &trackNumber, const QVariant &discNumber)
 {
     const auto realTitle = title.toString();
-    const auto realArtist = artist.toString();
-    const auto albumIsValid = !album.isNull() && album.isValid() && !album.toString().isEmpty();
+    const auto realArtist = ElisaUtils::internString(artist.toString());
+    const auto albumName = ElisaUtils::internString(album.toString());
+    const auto albumIsValid = !album.isNull() && album.isValid() && !albumName.isEmpty();
     auto realAlbum = std::optional<QString>{};
     if (albumIsValid) {
-        realAlbum = album.toString();
+        realAlbum = albumName;
     }
     auto trackNumberIsValid = bool{};
     const auto trackNumberValue = trackNumber.toInt(&trackNumberIsValid);
@@ -128,8 +150,7 @@ void TracksListener::trackByNameInList(const QVariant &title, const QVariant &ar
     auto newTrackId = d->mDatabase->trackIdFromTitleAlbumTrackDiscNumber(realTitle, realArtist, realAlbum,
                                                                          realTrackNumber, realDiscNumber);
     if (newTrackId == 0) {
-        auto newTrack = std::tuple<QString, QString, QString, int, int>(realTitle, realArtist, album.toString(), trackNumber.toInt(), discNumber.toInt());
-        d->mTracksByNameSet.push_back(newTrack);
+        d->mTracksByNameSet.insert({realTitle, realArtist, albumName, trackNumber.toInt(), discNumber.toInt()});
 
         return;
     }
@@ -281,6 +302,43 @@ void TracksListener::newUrlInList(const QUrl &entryUrl, ElisaUtils::PlayListEntr
     }
 }
 
+void TracksListener::newUrlsInList(const QList<QUrl> &entryUrls)
+{
+    qCDebug(orgKdeElisaPlayList()) << "TracksListener::newUrlsInList" << entryUrls.size();
+
+    const auto tracksIds = d->mDatabase->trackIdsFromFileNames(entryUrls);
+
+    auto knownTracksIds = QList<qulonglong>{};
+    knownTracksIds.reserve(tracksIds.size());
+    for (const auto &oneUrl : entryUrls) {
+        const auto oneTrackId = tracksIds.value(oneUrl);
+        if (!oneTrackId) {
+            trackByFileNameInList(ElisaUtils::FileName, oneUrl);
+            continue;
+        }
+
+        knownTracksIds.push_back(oneTrackId);
+    }
+
+    newTracksInList(knownTracksIds);
+}
+
+void TracksListener::newTracksInList(const QList<qulonglong> &newDatabaseIds)
+{
+    if (newDatabaseIds.isEmpty()) {
+        return;
+    }
+
+    for (auto oneTrackId : newDatabaseIds) {
+        d->mTracksByIdSet.insert(oneTrackId);
+    }
+
+    const auto newTracks = d->mDatabase->tracksDataFromDatabaseIds(newDatabaseIds);
+    if (!newTracks.isEmpty()) {
+        Q_EMIT tracksHaveChanged(newTracks);
+    }
+}
+
 void TracksListener::newArtistInList(qulonglong newDatabaseId, const QString &artist)
 {
     const auto newTracks = d->mDatabase->tracksDataFromAuthor(artist);
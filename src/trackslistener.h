@@ -37,6 +37,8 @@ Q_SIGNALS:
 
     void trackHasChanged(const TracksListener::TrackDataType &audioTrack);
 
+    void tracksHaveChanged(const TracksListener::ListTrackDataType &audioTracks);
+
     void trackHasBeenRemoved(qulonglong id);
 
     void tracksListAdded(qulonglong newDatabaseId,
@@ -63,6 +65,17 @@ public Q_SLOTS:
     void newUrlInList(const QUrl &entryUrl,
                       ElisaUtils::PlayListEntryType databaseIdType);
 
+    /**
+     * batched variant of newUrlInList for tracks, known tracks are resolved in a few queries
+     * and notified with a single tracksHaveChanged
+     */
+    void newUrlsInList(const QList<QUrl> &entryUrls);
+
+    /**
+     * batched variant of newEntryInList for tracks
+     */
+    void newTracksInList(const QList<qulonglong> &newDatabaseIds);
+
     void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
 
 private: